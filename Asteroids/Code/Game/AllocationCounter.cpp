@@ -0,0 +1,144 @@
+#include "Game/AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(ASTEROIDS_COUNT_ALLOCATIONS)
+
+namespace {
+
+std::atomic<uint64_t> s_allocations{0u};
+std::atomic<uint64_t> s_bytes{0u};
+
+void* CountedAllocate(std::size_t size) noexcept {
+    s_allocations.fetch_add(1u, std::memory_order_relaxed);
+    s_bytes.fetch_add(size, std::memory_order_relaxed);
+    //malloc(0) may return null, which operator new must not.
+    return std::malloc(size != 0u ? size : 1u);
+}
+
+void* CountedAllocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+    s_allocations.fetch_add(1u, std::memory_order_relaxed);
+    s_bytes.fetch_add(size, std::memory_order_relaxed);
+    const auto align = static_cast<std::size_t>(alignment);
+#if defined(_MSC_VER)
+    return _aligned_malloc(size != 0u ? size : 1u, align);
+#else
+    //aligned_alloc wants the size to be a multiple of the alignment.
+    return std::aligned_alloc(align, (size + align) / align * align);
+#endif
+}
+
+void FreeAligned(void* ptr) noexcept {
+#if defined(_MSC_VER)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // namespace
+
+AllocationCounter::Totals AllocationCounter::GetTotals() noexcept {
+    return Totals{s_allocations.load(std::memory_order_relaxed), s_bytes.load(std::memory_order_relaxed)};
+}
+
+void* operator new(std::size_t size) {
+    if(auto* ptr = CountedAllocate(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return CountedAllocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if(auto* ptr = CountedAllocateAligned(size, alignment)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return CountedAllocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return CountedAllocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    FreeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    FreeAligned(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    FreeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    FreeAligned(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    FreeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    FreeAligned(ptr);
+}
+
+#else
+
+AllocationCounter::Totals AllocationCounter::GetTotals() noexcept {
+    return Totals{};
+}
+
+#endif
+
+AllocationCounter::Totals AllocationCounter::GetSince(const Totals& earlier) noexcept {
+    const auto now = GetTotals();
+    return Totals{now.allocations - earlier.allocations, now.bytes - earlier.bytes};
+}
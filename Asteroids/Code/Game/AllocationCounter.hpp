@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+//Counts every allocation that goes through the global operator new, from any
+//thread and from any library linked into the game, engine and standard library
+//included. Per-frame figures come from taking the difference of two readings.
+//The replacement operators are only compiled where ASTEROIDS_COUNT_ALLOCATIONS
+//is defined (the Debug and DebugProfile configurations). Everywhere else, the
+//shipping FinalBuild included, the global allocator is left alone and every
+//reading is zero.
+class AllocationCounter {
+public:
+#if defined(ASTEROIDS_COUNT_ALLOCATIONS)
+    static inline constexpr const bool is_enabled = true;
+#else
+    static inline constexpr const bool is_enabled = false;
+#endif
+
+    struct Totals {
+        uint64_t allocations{0u};
+        uint64_t bytes{0u};
+    };
+
+    [[nodiscard]] static Totals GetTotals() noexcept;
+    //What was allocated since earlier was read.
+    [[nodiscard]] static Totals GetSince(const Totals& earlier) noexcept;
+
+protected:
+private:
+};
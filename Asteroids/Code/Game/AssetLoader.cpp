@@ -0,0 +1,116 @@
+#include "Game/AssetLoader.hpp"
+
+#include "Game/JobSystem.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+AssetLoader::~AssetLoader() noexcept {
+    JoinBackground();
+}
+
+void AssetLoader::Start(std::function<void()> background, std::vector<Step> steps) noexcept {
+    JoinBackground();
+    m_steps = std::move(steps);
+    m_next_step = 0u;
+    m_background_done.store(false, std::memory_order_relaxed);
+    m_started = true;
+    m_background = std::thread([this, background = std::move(background)]() {
+        const auto start = std::chrono::steady_clock::now();
+        if(background) {
+            background();
+        }
+        m_background_time = std::chrono::duration_cast<TimeUtils::FPSeconds>(std::chrono::steady_clock::now() - start);
+        m_background_done.store(true, std::memory_order_release);
+    });
+}
+
+bool AssetLoader::Pump(TimeUtils::FPSeconds budget) noexcept {
+    if(IsReady() || !m_started || !m_background_done.load(std::memory_order_acquire)) {
+        return false;
+    }
+    JoinBackground();
+    const auto start = std::chrono::steady_clock::now();
+    do {
+        RunStep(budget);
+    } while(!IsReady() && std::chrono::steady_clock::now() - start < budget);
+    return IsReady();
+}
+
+void AssetLoader::Finish() noexcept {
+    if(!m_started) {
+        return;
+    }
+    JoinBackground();
+    while(!IsReady()) {
+        RunStep(default_frame_budget);
+    }
+}
+
+bool AssetLoader::IsReady() const noexcept {
+    return m_started && m_next_step == m_steps.size();
+}
+
+const std::vector<AssetLoader::Step>& AssetLoader::GetSteps() const noexcept {
+    return m_steps;
+}
+
+TimeUtils::FPSeconds AssetLoader::GetBackgroundTime() const noexcept {
+    return m_background_time;
+}
+
+void AssetLoader::AppendFolderSteps(std::vector<Step>& steps, const std::string& name, const std::filesystem::path& folder, const std::string& extension, const std::function<void(const std::filesystem::path&)>& load) noexcept {
+    std::vector<std::filesystem::path> files{};
+    std::error_code ec{};
+    for(auto iter = std::filesystem::directory_iterator{folder, ec}; !ec && iter != std::filesystem::directory_iterator{}; iter.increment(ec)) {
+        if(iter->is_regular_file(ec) && iter->path().extension() == extension) {
+            files.push_back(iter->path());
+        }
+    }
+    std::sort(std::begin(files), std::end(files));
+    for(const auto& file : files) {
+        steps.push_back({name, [load, file]() { load(file); }, {}, file.filename().string()});
+    }
+}
+
+std::uintmax_t AssetLoader::Prefetch(JobSystem& jobs, const std::vector<std::filesystem::path>& folders) noexcept {
+    std::vector<std::filesystem::path> files{};
+    for(const auto& folder : folders) {
+        std::error_code ec{};
+        for(auto iter = std::filesystem::recursive_directory_iterator{folder, ec}; !ec && iter != std::filesystem::recursive_directory_iterator{}; iter.increment(ec)) {
+            if(iter->is_regular_file(ec)) {
+                files.push_back(iter->path());
+            }
+        }
+    }
+    std::atomic<std::uintmax_t> total{0u};
+    jobs.ParallelFor(files.size(), 1u, [&files, &total](std::size_t /*chunk*/, std::size_t begin, std::size_t end) {
+        std::array<char, 64u * 1024u> buffer{};
+        for(std::size_t i = begin; i < end; ++i) {
+            std::ifstream ifs{files[i], std::ios_base::binary};
+            while(ifs.read(buffer.data(), buffer.size()) || ifs.gcount() > 0) {
+                total.fetch_add(static_cast<std::uintmax_t>(ifs.gcount()), std::memory_order_relaxed);
+            }
+        }
+    });
+    return total.load(std::memory_order_relaxed);
+}
+
+void AssetLoader::RunStep(TimeUtils::FPSeconds budget) noexcept {
+    auto& step = m_steps[m_next_step++];
+    const auto start = std::chrono::steady_clock::now();
+    if(step.run) {
+        step.run();
+    }
+    step.elapsed = std::chrono::duration_cast<TimeUtils::FPSeconds>(std::chrono::steady_clock::now() - start);
+    step.overBudget = budget < step.elapsed;
+}
+
+void AssetLoader::JoinBackground() noexcept {
+    if(m_background.joinable()) {
+        m_background.join();
+    }
+}
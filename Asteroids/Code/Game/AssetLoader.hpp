@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Engine/Core/TimeUtils.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+
+//Loads the startup assets without holding up the first frame. A background
+//thread, which may fan out over the job system, runs first. The engine
+//registrations that follow are not thread-safe and only take file paths, so
+//they read and decode the files themselves as steps on the main thread, a few
+//per frame, once the background work is done. Folders are registered one file
+//per step so no single step outlasts a frame.
+class AssetLoader {
+public:
+    struct Step {
+        std::string name{};
+        std::function<void()> run{};
+        TimeUtils::FPSeconds elapsed{};
+        //The file a per-file step loads; empty for the rest.
+        std::string file{};
+        //Set when the step alone took longer than the frame budget it ran under.
+        bool overBudget{false};
+    };
+
+    static inline constexpr const TimeUtils::FPSeconds default_frame_budget{0.008f};
+
+    AssetLoader() noexcept = default;
+    AssetLoader(const AssetLoader& other) = delete;
+    AssetLoader(AssetLoader&& other) = delete;
+    AssetLoader& operator=(const AssetLoader& other) = delete;
+    AssetLoader& operator=(AssetLoader&& other) = delete;
+    //Waits for the background work; the steps that have not run are dropped.
+    ~AssetLoader() noexcept;
+
+    void Start(std::function<void()> background, std::vector<Step> steps) noexcept;
+    //Runs steps in order until budget is spent, but always at least one if the
+    //background work is done. True only on the call that runs the last step.
+    bool Pump(TimeUtils::FPSeconds budget) noexcept;
+    //Blocks until the background work and every step have run.
+    void Finish() noexcept;
+
+    [[nodiscard]] bool IsReady() const noexcept;
+    [[nodiscard]] const std::vector<Step>& GetSteps() const noexcept;
+    [[nodiscard]] TimeUtils::FPSeconds GetBackgroundTime() const noexcept;
+
+    //Appends one step named name per file directly in folder with the given
+    //extension, in path order, each of which calls load with that file's path.
+    static void AppendFolderSteps(std::vector<Step>& steps, const std::string& name, const std::filesystem::path& folder, const std::string& extension, const std::function<void(const std::filesystem::path&)>& load) noexcept;
+
+    //Reads every file under folders from the job system's threads and throws
+    //the bytes away. This only warms the OS file cache for the steps' own
+    //reads; nothing is decoded here. Returns the number of bytes read.
+    static std::uintmax_t Prefetch(JobSystem& jobs, const std::vector<std::filesystem::path>& folders) noexcept;
+
+protected:
+private:
+    void RunStep(TimeUtils::FPSeconds budget) noexcept;
+    void JoinBackground() noexcept;
+
+    std::thread m_background{};
+    std::atomic<bool> m_background_done{false};
+    TimeUtils::FPSeconds m_background_time{};
+    std::vector<Step> m_steps{};
+    std::size_t m_next_step{0u};
+    bool m_started{false};
+};
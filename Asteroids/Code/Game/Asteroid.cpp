@@ -10,13 +10,15 @@
 #include "Engine/Renderer/AnimatedSprite.hpp"
 #include "Engine/Renderer/Material.hpp"
 #include "Engine/Renderer/Shader.hpp"
-#include "Engine/Renderer/ConstantBuffer.hpp"
 
 #include "Engine/Scene/Components.hpp"
 
 #include "Engine/Services/ServiceLocator.hpp"
+#include "Engine/Services/IAudioService.hpp"
 #include "Engine/Services/IRendererService.hpp"
 
+#include "Game/CollisionResponse.hpp"
+#include "Game/EntityPool.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/GameConfig.hpp"
 #include "Game/Game.hpp"
@@ -29,6 +31,23 @@
 #include <type_traits>
 #include <vector>
 
+namespace {
+
+EntityPool<Asteroid, 512>& GetAsteroidPool() noexcept {
+    static EntityPool<Asteroid, 512> pool{};
+    return pool;
+}
+
+}
+
+void* Asteroid::operator new(std::size_t size) {
+    return GetAsteroidPool().Allocate(size);
+}
+
+void Asteroid::operator delete(void* ptr, std::size_t size) noexcept {
+    GetAsteroidPool().Deallocate(ptr, size);
+}
+
 Asteroid::Asteroid(std::weak_ptr<Scene> scene, Vector2 position, Vector2 velocity, float rotationSpeed)
     : Asteroid(scene, Type::Large, position, velocity, rotationSpeed) {/* DO NOTHING */}
 
@@ -38,6 +57,8 @@ Asteroid::Asteroid(std::weak_ptr<Scene> scene, Type type, Vector2 position, Vect
 {
     UpdateComponent<TransformComponent>(Matrix4::CreateTranslationMatrix(position));
     faction = GameEntity::Faction::Asteroid;
+    kind = GameEntity::Kind::Asteroid;
+    m_material = GetGameAs<Game>()->materials.asteroid;
     scoreValue = GetScoreFromType(type);
     SetHealth(GetHealthFromType(type));
     SetPosition(position);
@@ -47,19 +68,16 @@ Asteroid::Asteroid(std::weak_ptr<Scene> scene, Type type, Vector2 position, Vect
     SetCosmeticRadius(cosmeticRadius);
     SetPhysicalRadius(physicalRadius);
 
+    auto* rs = ServiceLocator::get<IRendererService>();
     AnimatedSpriteDesc desc{};
-    desc.material = g_theRenderer->GetMaterial("asteroid");
+    desc.material = GetMaterial();
     desc.spriteSheet = GetGameAs<Game>()->asteroid_sheet;
     desc.durationSeconds = TimeUtils::FPSeconds{1.0f};
     desc.playbackMode = AnimatedSprite::SpriteAnimMode::Looping;
     desc.frameLength = 30;
     desc.startSpriteIndex = 0;
 
-    if(auto cbs = GetMaterial()->GetShader()->GetConstantBuffers(); !cbs.empty()) {
-        asteroid_state_cb = &cbs[0].get();
-    }
-
-    _sprite = g_theRenderer->CreateAnimatedSprite(desc);
+    _sprite = rs->CreateAnimatedSprite(desc);
 
 }
 
@@ -73,45 +91,24 @@ void Asteroid::Update(TimeUtils::FPSeconds deltaSeconds) noexcept {
     } else if(theta > 0.0f) {
         RotateCounterClockwise(theta);
     };
+    //Headless runs have no sprite; everything below only feeds rendering.
+    if(!_sprite) {
+        return;
+    }
+    RefreshSpriteMaterial(*_sprite);
     _sprite->Update(deltaSeconds);
 
-    const auto uvs = _sprite->GetCurrentTexCoords();
     const auto frameWidth = static_cast<float>(_sprite->GetFrameDimensions().x);
     const auto frameHeight = static_cast<float>(_sprite->GetFrameDimensions().y);
     const auto extent_scale = _type == Type::Large ? 1.0f : (_type == Type::Medium ? 0.75f : (_type == Type::Small ? 0.50f : 1.0f));
     const auto half_extents = Vector2{frameWidth, frameHeight} * extent_scale;
-    {
-        const auto S = Matrix4::CreateScaleMatrix(half_extents);
-        const auto R = Matrix4::Create2DRotationDegreesMatrix(GetOrientationDegrees());
-        const auto T = Matrix4::CreateTranslationMatrix(GetPosition());
-        UpdateComponent<TransformComponent>(Matrix4::MakeSRT(S, R, T));
-    }
-
-    auto& builder = m_mesh_builder;
-    builder.Begin(PrimitiveType::Triangles);
-    builder.SetColor(Rgba::White);
-
-    builder.SetUV(Vector2{uvs.maxs.x, uvs.maxs.y});
-    builder.AddVertex(Vector2{+0.5f, +0.5f});
-
-    builder.SetUV(Vector2{uvs.mins.x, uvs.maxs.y});
-    builder.AddVertex(Vector2{-0.5f, +0.5f});
-
-    builder.SetUV(Vector2{uvs.mins.x, uvs.mins.y});
-    builder.AddVertex(Vector2{-0.5f, -0.5f});
-
-    builder.SetUV(Vector2{uvs.maxs.x, uvs.mins.y});
-    builder.AddVertex(Vector2{+0.5f, -0.5f});
-
-    builder.AddIndicies(Mesh::Builder::Primitive::Quad);
-    builder.End(GetMaterial());
-
+    UpdateTransform(half_extents);
 }
 
-void Asteroid::Render() const noexcept {
-    asteroid_state.wasHit = WasHit();
-    asteroid_state_cb->Update(*ServiceLocator::get<IRendererService>()->GetDeviceContext(), &asteroid_state);
-    GameEntity::Render();
+bool Asteroid::AppendToSpriteBatch(SpriteBatch& batch) const noexcept {
+    const auto uvs = _sprite ? _sprite->GetCurrentTexCoords() : AABB2::Zero_to_One;
+    batch.Add(m_material, MakeSpriteInstance(uvs, WasHit()), true);
+    return true;
 }
 
 Vector4 Asteroid::WasHit() const noexcept {
@@ -153,26 +150,20 @@ void Asteroid::OnDestroy() noexcept {
     }
 }
 
-Material* Asteroid::GetMaterial() const noexcept {
-    return g_theRenderer->GetMaterial("asteroid");
-}
-
 void Asteroid::MakeChildAsteroid() const noexcept {
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        if (auto* const mainState = dynamic_cast<MainState* const>(game->GetCurrentState()); mainState != nullptr) {
-            const auto [position, velocity, rotation] = CalcChildPhysicsParameters();
-            switch (_type) {
-            case Type::Large:
-                mainState->MakeMediumAsteroid(position, velocity, rotation);
-                break;
-            case Type::Medium:
-                mainState->MakeSmallAsteroid(position, velocity, rotation);
-                break;
-            case Type::Small:
-                break;
-            default:
-                break;
-            }
+        const auto [position, velocity, rotation] = CalcChildPhysicsParameters();
+        switch (_type) {
+        case Type::Large:
+            game->GetSpawnQueue().Push(SpawnRequest::ForAsteroid(static_cast<uint8_t>(Type::Medium), position, velocity, rotation));
+            break;
+        case Type::Medium:
+            game->GetSpawnQueue().Push(SpawnRequest::ForAsteroid(static_cast<uint8_t>(Type::Small), position, velocity, rotation));
+            break;
+        case Type::Small:
+            break;
+        default:
+            break;
         }
     }
 }
@@ -185,38 +176,25 @@ void Asteroid::OnHit() noexcept {
     if(TimeUtils::FPFrames{1.0f} < _timeSinceLastHit) {
         _timeSinceLastHit = _timeSinceLastHit.zero();
     }
-    AudioSystem::SoundDesc desc{};
-    desc.groupName = g_audiogroup_sound;
-    g_theAudioSystem->Play(g_sound_hitpath, desc);
-    asteroid_state.wasHit = WasHit();
+    if(auto* game = GetGameAs<Game>(); game != nullptr) {
+        game->GetAudio().Play(game->sounds.hit);
+    }
 }
 
 void Asteroid::OnCollision(GameEntity* a, GameEntity* b) noexcept {
-    if(a->faction == b->faction) {
-        return;
-    }
-    switch(b->faction) {
-    case GameEntity::Faction::Player:
-    {
-        if(auto* asBullet = dynamic_cast<Bullet*>(b); asBullet != nullptr) {
-            a->DecrementHealth();
-            asBullet->DecrementHealth();
-            OnHit();
-        }
-        if(auto* asMine = dynamic_cast<Mine*>(b); asMine != nullptr) {
-            a->Kill();
-            b->Kill();
-            OnHit();
-        }
-    }
-    break;
-    case GameEntity::Faction::Enemy:
-    /* DO NOTHING */
-    break;
-    default: break;
-    }
-    
+    CollisionResponse::Dispatch(*a, *b);
+}
+
+void Asteroid::OnHitBy(Bullet& bullet) noexcept {
+    DecrementHealth();
+    bullet.DecrementHealth();
+    OnHit();
+}
 
+void Asteroid::OnHitBy(Mine& mine) noexcept {
+    Kill();
+    mine.Kill();
+    OnHit();
 }
 
 void Asteroid::OnCreate() noexcept {
@@ -241,11 +219,11 @@ float Asteroid::CalcChildHeadingFromDifficulty() const noexcept {
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
         switch(game->gameOptions.GetDifficulty()) {
         case Difficulty::Easy:
-            return MathUtils::GetRandomZeroToOne<float>() * 360.0f;
+            return GetRandom().GetZeroToOne<float>() * 360.0f;
         case Difficulty::Normal:
-            return currentHeading + MathUtils::GetRandomNegOneToOne<float>() * 90.0f;
+            return currentHeading + GetRandom().GetNegOneToOne<float>() * 90.0f;
         case Difficulty::Hard:
-            return currentHeading + MathUtils::GetRandomNegOneToOne<float>() * 45.0f;
+            return currentHeading + GetRandom().GetNegOneToOne<float>() * 45.0f;
         default:
             return currentHeading;
         }
@@ -274,9 +252,9 @@ float Asteroid::CalcChildSpeedFromSize() const noexcept {
     const auto currentSpeed = GetVelocity().CalcLength();
     switch(_type) {
     case Type::Large:
-        return currentSpeed * MathUtils::GetRandomInRange<float>(2.0f, 2.2f);
+        return currentSpeed * GetRandom().GetInRange<float>(2.0f, 2.2f);
     case Type::Medium:
-        return currentSpeed * MathUtils::GetRandomInRange<float>(2.5f, 2.6f);
+        return currentSpeed * GetRandom().GetInRange<float>(2.5f, 2.6f);
     case Type::Small:
         return currentSpeed;
     default:
@@ -289,7 +267,7 @@ std::tuple<Vector2, Vector2, float> Asteroid::CalcChildPhysicsParameters() const
     const auto speed = CalcChildSpeedFromSizeAndDifficulty();
     auto v = GetVelocity();
     v.SetLengthAndHeadingDegrees(heading, speed);
-    const auto r = MathUtils::GetRandomZeroToOne<float>() * 360.0f;
-    const auto p = MathUtils::GetRandomPointInside(Disc2{GetPosition(), GetCosmeticRadius()});
+    const auto r = GetRandom().GetZeroToOne<float>() * 360.0f;
+    const auto p = GetRandom().GetPointInsideDisc(GetPosition(), GetCosmeticRadius());
     return std::make_tuple(p,v,r);
 }
@@ -5,12 +5,14 @@
 
 #include "Game/GameEntity.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <tuple>
 #include <utility>
 
 class Renderer;
-class ConstantBuffer;
+class Bullet;
+class Mine;
 
 class Asteroid : public GameEntity {
 public:
@@ -35,16 +37,20 @@ public:
 
     virtual ~Asteroid() = default;
 
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size) noexcept;
+
     void Update(TimeUtils::FPSeconds deltaSeconds) noexcept override;
-    void Render() const noexcept override;
+    bool AppendToSpriteBatch(SpriteBatch& batch) const noexcept override;
     void EndFrame() noexcept override;
 
     void OnCreate() noexcept override;
     void OnFire() noexcept override;
     void OnCollision(GameEntity* a, GameEntity* b) noexcept override;
+    void OnHitBy(Bullet& bullet) noexcept;
+    void OnHitBy(Mine& mine) noexcept;
     void OnDestroy() noexcept override;
 
-    Material* GetMaterial() const noexcept override;
 
     static constexpr long long GetScoreFromType(Type type) noexcept {
         switch(type) {
@@ -77,12 +83,6 @@ private:
     float CalcChildSpeedFromSize() const noexcept;
     std::tuple<Vector2, Vector2, float> CalcChildPhysicsParameters() const noexcept;
 
-    struct asteroid_state_t {
-        Vector4 wasHit{};
-    };
-
-    ConstantBuffer* asteroid_state_cb{nullptr};
-    mutable asteroid_state_t asteroid_state{};
     Type _type{Type::Large};
     TimeUtils::FPSeconds _timeSinceLastHit{0.0f};
     std::unique_ptr<class AnimatedSprite> _sprite{};
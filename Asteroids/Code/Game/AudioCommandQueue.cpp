@@ -0,0 +1,75 @@
+#include "Game/AudioCommandQueue.hpp"
+
+#include <algorithm>
+#include <bit>
+
+AudioCommandQueue::AudioCommandQueue(std::size_t capacity) noexcept {
+    const auto size = std::bit_ceil((std::max)(capacity, std::size_t{2u}));
+    m_slots = std::make_unique<Slot[]>(size);
+    m_mask = size - 1u;
+    for(std::size_t i = 0u; i < size; ++i) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool AudioCommandQueue::TryPush(const AudioCommand& command) noexcept {
+    auto position = m_head.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while(true) {
+        slot = &m_slots[position & m_mask];
+        const auto sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if(difference == 0) {
+            if(m_head.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if(difference < 0) {
+            //The consumer has not freed this slot since the last lap.
+            m_dropped.fetch_add(1u, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = m_head.load(std::memory_order_relaxed);
+        }
+    }
+    slot->command = command;
+    slot->sequence.store(position + 1u, std::memory_order_release);
+    m_pushed.fetch_add(1u, std::memory_order_relaxed);
+    //The consumer may already be past this command, which counts as empty.
+    const auto tail = m_tail.load(std::memory_order_relaxed);
+    RaisePeakDepth(position + 1u > tail ? position + 1u - tail : 0u);
+    return true;
+}
+
+bool AudioCommandQueue::TryPop(AudioCommand& command) noexcept {
+    const auto position = m_tail.load(std::memory_order_relaxed);
+    auto& slot = m_slots[position & m_mask];
+    if(slot.sequence.load(std::memory_order_acquire) != position + 1u) {
+        return false;
+    }
+    command = slot.command;
+    //Hands the slot back to the producer that reaches it on the next lap.
+    slot.sequence.store(position + m_mask + 1u, std::memory_order_release);
+    m_tail.store(position + 1u, std::memory_order_relaxed);
+    return true;
+}
+
+std::size_t AudioCommandQueue::GetCapacity() const noexcept {
+    return m_mask + 1u;
+}
+
+std::size_t AudioCommandQueue::GetDepth() const noexcept {
+    const auto tail = m_tail.load(std::memory_order_relaxed);
+    const auto head = m_head.load(std::memory_order_relaxed);
+    return head > tail ? head - tail : 0u;
+}
+
+AudioCommandQueue::Stats AudioCommandQueue::GetStats() const noexcept {
+    return Stats{m_pushed.load(std::memory_order_relaxed), m_dropped.load(std::memory_order_relaxed), m_peak_depth.load(std::memory_order_relaxed), GetCapacity()};
+}
+
+void AudioCommandQueue::RaisePeakDepth(std::size_t depth) noexcept {
+    auto peak = m_peak_depth.load(std::memory_order_relaxed);
+    while(peak < depth && !m_peak_depth.compare_exchange_weak(peak, depth, std::memory_order_relaxed)) {
+        /* DO NOTHING */
+    }
+}
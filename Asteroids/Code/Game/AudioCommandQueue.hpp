@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+//Index of a sound resolved by the AudioDispatcher at startup, so a command
+//carries a number instead of a path.
+struct SoundHandle {
+    static inline constexpr const uint32_t invalid_index = (std::numeric_limits<uint32_t>::max)();
+
+    uint32_t index{invalid_index};
+
+    [[nodiscard]] constexpr bool IsValid() const noexcept {
+        return index != invalid_index;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const SoundHandle& a, const SoundHandle& b) noexcept = default;
+};
+
+struct AudioCommand {
+    enum class Type : uint8_t {
+        Play
+        , Stop
+    };
+
+    Type type{Type::Play};
+    SoundHandle sound{};
+    float volume{1.0f};
+    //steady_clock ticks at the time of the push, for measuring queue latency.
+    int64_t enqueuedAt{0};
+};
+
+static_assert(std::is_trivially_copyable_v<AudioCommand>);
+
+//Bounded lock-free ring with any number of producers and a single consumer.
+//Every slot carries a sequence number that says whose turn it is, so producers
+//only contend on claiming a position and never wait on the consumer. A push
+//into a full ring is dropped and counted rather than blocking gameplay.
+class AudioCommandQueue {
+public:
+    struct Stats {
+        uint64_t pushed{0u};
+        uint64_t dropped{0u};
+        std::size_t peakDepth{0u};
+        std::size_t capacity{0u};
+    };
+
+    //capacity is rounded up to a power of two.
+    explicit AudioCommandQueue(std::size_t capacity) noexcept;
+    AudioCommandQueue(const AudioCommandQueue& other) = delete;
+    AudioCommandQueue(AudioCommandQueue&& other) = delete;
+    AudioCommandQueue& operator=(const AudioCommandQueue& other) = delete;
+    AudioCommandQueue& operator=(AudioCommandQueue&& other) = delete;
+    ~AudioCommandQueue() noexcept = default;
+
+    //Safe from any thread. False if the ring was full and command was dropped.
+    bool TryPush(const AudioCommand& command) noexcept;
+    //Only ever called by the one consumer.
+    bool TryPop(AudioCommand& command) noexcept;
+
+    [[nodiscard]] std::size_t GetCapacity() const noexcept;
+    //Approximate while producers are pushing.
+    [[nodiscard]] std::size_t GetDepth() const noexcept;
+    [[nodiscard]] Stats GetStats() const noexcept;
+
+protected:
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence{0u};
+        AudioCommand command{};
+    };
+
+    void RaisePeakDepth(std::size_t depth) noexcept;
+
+    static inline constexpr const std::size_t cache_line_size = 64u;
+
+    std::unique_ptr<Slot[]> m_slots{};
+    std::size_t m_mask{0u};
+    //Kept on separate cache lines so producers claiming slots do not slow the consumer down.
+    alignas(cache_line_size) std::atomic<std::size_t> m_head{0u};
+    alignas(cache_line_size) std::atomic<std::size_t> m_tail{0u};
+    alignas(cache_line_size) std::atomic<uint64_t> m_pushed{0u};
+    std::atomic<uint64_t> m_dropped{0u};
+    std::atomic<std::size_t> m_peak_depth{0u};
+};
@@ -0,0 +1,121 @@
+#include "Game/AudioDispatcher.hpp"
+
+#include "Game/IAudioBackend.hpp"
+
+AudioDispatcher::AudioDispatcher(std::size_t capacity /*= default_capacity*/) noexcept
+: m_queue(capacity)
+{
+    /* DO NOTHING */
+}
+
+AudioDispatcher::~AudioDispatcher() noexcept {
+    Shutdown();
+}
+
+void AudioDispatcher::SetBackend(IAudioBackend* backend) noexcept {
+    m_backend = backend;
+}
+
+SoundHandle AudioDispatcher::Register(const std::filesystem::path& path, bool looping /*= false*/) noexcept {
+    const auto sound = SoundHandle{static_cast<uint32_t>(m_sounds.size())};
+    m_sounds.push_back(Sound{path, looping});
+    return sound;
+}
+
+void AudioDispatcher::Start(bool threaded) noexcept {
+    if(m_started) {
+        return;
+    }
+    m_started = true;
+    if(m_backend) {
+        for(uint32_t i = 0u; i < m_sounds.size(); ++i) {
+            m_backend->Load(SoundHandle{i}, m_sounds[i].path, m_sounds[i].looping);
+        }
+    }
+    if(threaded) {
+        m_running.store(true, std::memory_order_relaxed);
+        m_thread = std::thread(&AudioDispatcher::ThreadLoop, this);
+    }
+}
+
+void AudioDispatcher::Shutdown() noexcept {
+    if(m_thread.joinable()) {
+        m_running.store(false, std::memory_order_relaxed);
+        m_thread.join();
+    }
+    if(m_started) {
+        Drain();
+        m_started = false;
+    }
+}
+
+bool AudioDispatcher::Play(SoundHandle sound, float volume /*= 1.0f*/) noexcept {
+    return Post(AudioCommand::Type::Play, sound, volume);
+}
+
+bool AudioDispatcher::Stop(SoundHandle sound) noexcept {
+    return Post(AudioCommand::Type::Stop, sound, 0.0f);
+}
+
+void AudioDispatcher::Flush() noexcept {
+    if(m_started && !m_thread.joinable()) {
+        Drain();
+    }
+}
+
+bool AudioDispatcher::IsThreaded() const noexcept {
+    return m_thread.joinable();
+}
+
+AudioDispatcher::Stats AudioDispatcher::GetStats() const noexcept {
+    using milliseconds = std::chrono::duration<double, std::milli>;
+    Stats stats{};
+    stats.queue = m_queue.GetStats();
+    stats.dispatched = m_dispatched.load(std::memory_order_relaxed);
+    if(stats.dispatched != 0u) {
+        const auto total = std::chrono::steady_clock::duration{m_total_latency.load(std::memory_order_relaxed)};
+        stats.meanLatency = std::chrono::duration_cast<milliseconds>(total) / static_cast<double>(stats.dispatched);
+    }
+    stats.maxLatency = std::chrono::duration_cast<milliseconds>(std::chrono::steady_clock::duration{m_max_latency.load(std::memory_order_relaxed)});
+    return stats;
+}
+
+bool AudioDispatcher::Post(AudioCommand::Type type, SoundHandle sound, float volume) noexcept {
+    if(!sound.IsValid()) {
+        return false;
+    }
+    const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    return m_queue.TryPush(AudioCommand{type, sound, volume, static_cast<int64_t>(now)});
+}
+
+void AudioDispatcher::Drain() noexcept {
+    AudioCommand command{};
+    while(m_queue.TryPop(command)) {
+        if(m_backend) {
+            switch(command.type) {
+            case AudioCommand::Type::Play:
+                m_backend->Play(command.sound, command.volume);
+                break;
+            case AudioCommand::Type::Stop:
+                m_backend->Stop(command.sound);
+                break;
+            default:
+                break;
+            }
+        }
+        //Only this thread writes the counters, so plain stores are enough.
+        const auto latency = static_cast<int64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) - command.enqueuedAt;
+        m_dispatched.store(m_dispatched.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+        m_total_latency.store(m_total_latency.load(std::memory_order_relaxed) + latency, std::memory_order_relaxed);
+        if(m_max_latency.load(std::memory_order_relaxed) < latency) {
+            m_max_latency.store(latency, std::memory_order_relaxed);
+        }
+    }
+}
+
+void AudioDispatcher::ThreadLoop() noexcept {
+    while(m_running.load(std::memory_order_relaxed)) {
+        Drain();
+        std::this_thread::sleep_for(idle_sleep);
+    }
+}
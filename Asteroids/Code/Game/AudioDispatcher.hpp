@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Game/AudioCommandQueue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+class IAudioBackend;
+
+//Takes sound playback off the simulation thread. Gameplay code posts small
+//commands naming sounds resolved at startup; a dedicated audio thread drains
+//them into the backend, so the path lookup and channel allocation of a play
+//never land in entity logic. Without the thread, Flush drains on the caller.
+//Handles are valid from Register, so commands posted before Start wait in the
+//queue until Start has loaded the sounds.
+class AudioDispatcher {
+public:
+    struct Stats {
+        AudioCommandQueue::Stats queue{};
+        uint64_t dispatched{0u};
+        //Time from the push to the backend call.
+        std::chrono::duration<double, std::milli> meanLatency{};
+        std::chrono::duration<double, std::milli> maxLatency{};
+    };
+
+    static inline constexpr const std::size_t default_capacity = 256u;
+    //How long the audio thread sleeps when it finds the queue empty.
+    static inline constexpr const std::chrono::milliseconds idle_sleep{1};
+
+    explicit AudioDispatcher(std::size_t capacity = default_capacity) noexcept;
+    AudioDispatcher(const AudioDispatcher& other) = delete;
+    AudioDispatcher(AudioDispatcher&& other) = delete;
+    AudioDispatcher& operator=(const AudioDispatcher& other) = delete;
+    AudioDispatcher& operator=(AudioDispatcher&& other) = delete;
+    ~AudioDispatcher() noexcept;
+
+    //Setting the backend and registering sounds are only done before Start.
+    void SetBackend(IAudioBackend* backend) noexcept;
+    //Only hands out the handle; the backend loads the sound in Start.
+    [[nodiscard]] SoundHandle Register(const std::filesystem::path& path, bool looping = false) noexcept;
+    //Loads every registered sound on the calling thread, then starts the audio thread if asked.
+    //Only thread a backend that nothing else drives; otherwise leave Flush to the thread that does.
+    void Start(bool threaded) noexcept;
+    //Dispatches whatever is still queued, then stops the audio thread.
+    void Shutdown() noexcept;
+
+    //Safe from any thread. False if the command was dropped.
+    bool Play(SoundHandle sound, float volume = 1.0f) noexcept;
+    bool Stop(SoundHandle sound) noexcept;
+    //Drains the queue on the calling thread unless the audio thread is running.
+    void Flush() noexcept;
+
+    [[nodiscard]] bool IsThreaded() const noexcept;
+    [[nodiscard]] Stats GetStats() const noexcept;
+
+protected:
+private:
+    bool Post(AudioCommand::Type type, SoundHandle sound, float volume) noexcept;
+    void Drain() noexcept;
+    void ThreadLoop() noexcept;
+
+    struct Sound {
+        std::filesystem::path path{};
+        bool looping{false};
+    };
+
+    AudioCommandQueue m_queue;
+    IAudioBackend* m_backend{nullptr};
+    std::vector<Sound> m_sounds{};
+    std::thread m_thread{};
+    std::atomic<bool> m_running{false};
+    bool m_started{false};
+    std::atomic<uint64_t> m_dispatched{0u};
+    std::atomic<int64_t> m_total_latency{0};
+    std::atomic<int64_t> m_max_latency{0};
+};
@@ -0,0 +1,441 @@
+#include "Game/BenchmarkRunner.hpp"
+
+#include "Engine/Math/Matrix4.hpp"
+#include "Engine/Math/Vector2.hpp"
+
+#include "Game/Game.hpp"
+#include "Game/Asteroid.hpp"
+#include "Game/KinematicsStore.hpp"
+#include "Game/RandomStream.hpp"
+#include "Game/Ufo.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <memory>
+
+namespace {
+
+//Large enough that no scenario ends in a game over part way through.
+constexpr const long long benchmark_lives = 1'000'000ll;
+constexpr const std::size_t render_build_phase = static_cast<std::size_t>(MainState::FramePhase::RenderBuild);
+constexpr const std::size_t default_state_mode = static_cast<std::size_t>(SpriteBatch::default_state_mode);
+
+//One entity's share of the store, laid out the way GameEntity held it before.
+struct PerEntityKinematics {
+    Vector2 position{};
+    float orientationDegrees{0.0f};
+    float speed{0.0f};
+    Vector2 direction{};
+    Vector2 acceleration{};
+    Vector2 force{};
+    float inverseMass{1.0f};
+    Vector2 scale{};
+    Matrix4 transform{};
+};
+
+//What GameEntity::Update and UpdateTransform did for one entity before the
+//batched pass: integrate, rebuild the direction from the heading, then
+//multiply the scale, rotation and translation matrices.
+void StepPerEntity(PerEntityKinematics& entity, float deltaSeconds) noexcept {
+    const auto new_accel = entity.force * entity.inverseMass;
+    const auto new_vel = entity.direction * entity.speed + new_accel * deltaSeconds;
+    entity.position = entity.position + new_vel * deltaSeconds;
+    entity.speed = new_vel.CalcLength();
+    auto new_direction = Vector2::X_Axis;
+    new_direction.SetUnitLengthAndHeadingDegrees(new_vel.CalcHeadingDegrees());
+    entity.direction = new_direction;
+    entity.acceleration = new_accel;
+    const auto S = Matrix4::CreateScaleMatrix(entity.scale);
+    const auto R = Matrix4::Create2DRotationDegreesMatrix(entity.orientationDegrees);
+    const auto T = Matrix4::CreateTranslationMatrix(entity.position);
+    entity.transform = Matrix4::MakeSRT(S, R, T);
+}
+
+constexpr const std::size_t small_asteroid_count = 10'000u;
+constexpr const std::size_t boss_ufo_count = 64u;
+constexpr const std::size_t kill_all_interval = 30u;
+
+} // namespace
+
+BenchmarkRunner::BenchmarkRunner(const Options& options) noexcept
+: m_options(options)
+{
+    /* DO NOTHING */
+}
+
+std::vector<BenchmarkRunner::ScenarioResult> BenchmarkRunner::Run(Game& game) noexcept {
+    std::vector<ScenarioResult> results{};
+    const auto original_difficulty = game.gameOptions.GetDifficulty();
+    for(auto i = std::size_t{0u}; i < static_cast<std::size_t>(Scenario::Max); ++i) {
+        const auto scenario = static_cast<Scenario>(i);
+        if(m_options.scenario != "all" && m_options.scenario != GetScenarioName(scenario)) {
+            continue;
+        }
+        results.push_back(RunScenario(game, scenario));
+        game.gameOptions.SetDifficulty(original_difficulty);
+    }
+    return results;
+}
+
+std::vector<BenchmarkRunner::IntegrateResult> BenchmarkRunner::RunIntegrate(uint64_t seed) const noexcept {
+    std::vector<IntegrateResult> results{};
+    if(m_options.scenario != "all" && m_options.scenario != integrate_scenario_name) {
+        return results;
+    }
+    for(const auto slots : integrate_slot_counts) {
+        results.push_back(RunIntegrateSlots(seed, slots));
+    }
+    return results;
+}
+
+BenchmarkRunner::IntegrateResult BenchmarkRunner::RunIntegrateSlots(uint64_t seed, std::size_t slots) const noexcept {
+    IntegrateResult result{};
+    result.slots = slots;
+    //The store and the per-entity copies start from the same values, so any
+    //difference comes from the batched pass.
+    KinematicsStore store{};
+    std::vector<PerEntityKinematics> entities{};
+    store.Reserve(slots + integrate_pending_slots);
+    entities.reserve(slots);
+    RandomStream rng{seed, RandomStream::Subsystem::Benchmark};
+    const auto add_slot = [&]() {
+        const auto i = store.Acquire(nullptr);
+        const auto heading = rng.GetInRange<float>(0.0f, 6.2831853f);
+        auto& entity = entities.emplace_back();
+        entity.position = Vector2{rng.GetInRange<float>(-800.0f, 800.0f), rng.GetInRange<float>(-450.0f, 450.0f)};
+        entity.orientationDegrees = rng.GetInRange<float>(0.0f, 360.0f);
+        entity.speed = rng.GetBool() ? rng.GetInRange<float>(0.0f, 200.0f) : 0.0f;
+        entity.direction = Vector2{std::cos(heading), std::sin(heading)};
+        entity.force = Vector2{rng.GetNegOneToOne<float>() * 500.0f, rng.GetNegOneToOne<float>() * 500.0f};
+        entity.inverseMass = rng.GetInRange<float>(0.01f, 1.0f);
+        entity.scale = Vector2{rng.GetInRange<float>(8.0f, 64.0f), rng.GetInRange<float>(8.0f, 64.0f)};
+        store.position_x[i] = entity.position.x;
+        store.position_y[i] = entity.position.y;
+        store.orientation_degrees[i] = entity.orientationDegrees;
+        store.speed[i] = entity.speed;
+        store.direction_x[i] = entity.direction.x;
+        store.direction_y[i] = entity.direction.y;
+        store.force_x[i] = entity.force.x;
+        store.force_y[i] = entity.force.y;
+        store.inverse_mass[i] = entity.inverseMass;
+        store.scale_x[i] = entity.scale.x;
+        store.scale_y[i] = entity.scale.y;
+        store.has_transform[i] = 1u;
+    };
+    for(auto i = std::size_t{0u}; i < slots; ++i) {
+        add_slot();
+    }
+    store.CommitPending();
+    for(auto i = std::size_t{0u}; i < integrate_pending_slots; ++i) {
+        add_slot();
+    }
+    entities.resize(slots);
+    const auto pending_x = std::vector<float>(std::cbegin(store.position_x) + slots, std::cend(store.position_x));
+    const auto pending_y = std::vector<float>(std::cbegin(store.position_y) + slots, std::cend(store.position_y));
+    const auto pending_transforms = std::vector<Matrix4>(std::cbegin(store.transform) + slots, std::cend(store.transform));
+
+    const auto samples = m_options.frames;
+    const auto dt = m_options.frameDuration.count();
+    std::vector<double> batched_ms{};
+    std::vector<double> per_entity_ms{};
+    batched_ms.reserve(samples);
+    per_entity_ms.reserve(samples);
+    for(auto i = std::size_t{0u}; i < samples; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        store.Integrate(dt);
+        store.CalcTransforms(0u, store.CommittedSize());
+        batched_ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        start = std::chrono::steady_clock::now();
+        for(auto& entity : entities) {
+            StepPerEntity(entity, dt);
+        }
+        per_entity_ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    result.batched = Summarize(batched_ms);
+    result.perEntity = Summarize(per_entity_ms);
+
+    //Rounding differences compound chaotically wherever a velocity passes near
+    //zero, so the paths are compared over one step from the same state.
+    for(auto i = std::size_t{0u}; i < slots; ++i) {
+        auto& entity = entities[i];
+        entity.position = Vector2{store.position_x[i], store.position_y[i]};
+        entity.speed = store.speed[i];
+        entity.direction = Vector2{store.direction_x[i], store.direction_y[i]};
+        StepPerEntity(entity, dt);
+    }
+    store.Integrate(dt);
+    store.CalcTransforms(0u, store.CommittedSize());
+
+    const auto check = [&result](float actual, float expected) {
+        const auto error = std::abs(actual - expected) / (std::max)(1.0f, std::abs(expected));
+        result.maxRelativeError = (std::max)(result.maxRelativeError, error);
+    };
+    for(auto i = std::size_t{0u}; i < slots; ++i) {
+        const auto& entity = entities[i];
+        check(store.position_x[i], entity.position.x);
+        check(store.position_y[i], entity.position.y);
+        check(store.speed[i], entity.speed);
+        check(store.direction_x[i], entity.direction.x);
+        check(store.direction_y[i], entity.direction.y);
+        check(store.acceleration_x[i], entity.acceleration.x);
+        check(store.acceleration_y[i], entity.acceleration.y);
+        const auto* batched = store.transform[i].GetAsFloatArray();
+        const auto* expected = entity.transform.GetAsFloatArray();
+        for(auto j = std::size_t{0u}; j < 16u; ++j) {
+            check(batched[j], expected[j]);
+        }
+    }
+    result.withinTolerance = result.maxRelativeError <= integrate_tolerance;
+    result.pendingUntouched = std::equal(std::cbegin(pending_x), std::cend(pending_x), std::cbegin(store.position_x) + slots)
+                           && std::equal(std::cbegin(pending_y), std::cend(pending_y), std::cbegin(store.position_y) + slots)
+                           && std::equal(std::cbegin(pending_transforms), std::cend(pending_transforms), std::cbegin(store.transform) + slots, [](const Matrix4& a, const Matrix4& b) {
+                                  return std::equal(a.GetAsFloatArray(), a.GetAsFloatArray() + 16, b.GetAsFloatArray());
+                              });
+    return result;
+}
+
+BenchmarkRunner::ScenarioResult BenchmarkRunner::RunScenario(Game& game, Scenario scenario) noexcept {
+    ScenarioResult result{};
+    result.scenario = scenario;
+    if(scenario == Scenario::Wave50Hard) {
+        game.gameOptions.SetDifficulty(Difficulty::Hard);
+    }
+    game.ChangeState(std::make_unique<MainState>());
+    game.BeginFrame();
+    auto* state = dynamic_cast<MainState*>(game.GetCurrentState());
+    if(state == nullptr) {
+        return result;
+    }
+    game.player.desc.lives = benchmark_lives;
+    SetUpScenario(*state, scenario);
+    game.EndFrame();
+
+    std::array<std::vector<double>, phase_count> samples{};
+    for(auto& s : samples) {
+        s.reserve(m_options.frames);
+    }
+    std::array<std::vector<double>, state_mode_count> state_mode_samples{};
+    for(auto& s : state_mode_samples) {
+        s.reserve(m_options.frames);
+    }
+    const auto total_frames = m_options.warmupFrames + m_options.frames;
+    for(auto frame = std::size_t{0u}; frame < total_frames; ++frame) {
+        const auto start = std::chrono::steady_clock::now();
+        game.BeginFrame();
+        StepScenario(*state, scenario, frame);
+        state->Update(m_options.frameDuration);
+        //EndFrame clears the phase totals on the next BeginFrame, so read them first.
+        const auto phases = state->GetFramePhaseTimes();
+        const auto entity_count = state->m_entities.size();
+        game.EndFrame();
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if(frame < m_options.warmupFrames) {
+            continue;
+        }
+        for(auto p = std::size_t{0u}; p < phases.size(); ++p) {
+            if(p != render_build_phase) {
+                samples[p].push_back(static_cast<double>(phases[p].count()) * 1000.0);
+            }
+        }
+        samples.back().push_back(elapsed);
+        result.peakEntities = (std::max)(result.peakEntities, entity_count);
+        ++result.frames;
+        RecordSpriteStateModes(*state, state_mode_samples, result);
+        //Headless frames never render, so the phase is the snapshot capture and
+        //batching the game would do, in the mode it uses by default.
+        samples[render_build_phase].push_back(state_mode_samples[default_state_mode].back());
+    }
+    for(auto p = std::size_t{0u}; p < phase_count; ++p) {
+        result.phases[p] = Summarize(samples[p]);
+    }
+    for(auto m = std::size_t{0u}; m < state_mode_count; ++m) {
+        auto& stats = result.spriteState[m];
+        stats.build = Summarize(state_mode_samples[m]);
+        if(result.frames != 0u) {
+            const auto frames = static_cast<double>(result.frames);
+            stats.render.meanDraws /= frames;
+            stats.render.meanStateChanges /= frames;
+            stats.render.meanBytesUploaded /= frames;
+        }
+    }
+    return result;
+}
+
+void BenchmarkRunner::RecordSpriteStateModes(const MainState& state, std::array<std::vector<double>, state_mode_count>& samples, ScenarioResult& result) noexcept {
+    auto& snapshot = m_state_mode_snapshot;
+    for(auto m = std::size_t{0u}; m < state_mode_count; ++m) {
+        snapshot.Clear();
+        snapshot.sprites.SetStateMode(static_cast<SpriteBatch::StateMode>(m));
+        //The world bounds keep every entity in, so both modes batch the same sprites.
+        const auto start = std::chrono::steady_clock::now();
+        state.CaptureRenderSnapshot(snapshot, state.m_world_bounds);
+        snapshot.sprites.End();
+        const auto submission = snapshot.sprites.Record();
+        samples[m].push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        auto& stats = result.spriteState[m];
+        stats.peakDraws = (std::max)(stats.peakDraws, submission.draws);
+        stats.peakStateUploads = (std::max)(stats.peakStateUploads, submission.stateUploads);
+
+        m_recorder.BeginFrame();
+        state.RenderEntities(snapshot, m_recorder);
+        const auto& recorded = m_recorder.GetFrameStats();
+        auto& render = stats.render;
+        //Summed here and divided by the frame count once the scenario is done.
+        render.meanDraws += static_cast<double>(recorded.draws);
+        render.meanStateChanges += static_cast<double>(recorded.stateChanges);
+        render.meanBytesUploaded += static_cast<double>(recorded.bytesUploaded);
+        render.peakDraws = (std::max)(render.peakDraws, recorded.draws);
+        render.peakStateChanges = (std::max)(render.peakStateChanges, recorded.stateChanges);
+        render.peakBytesUploaded = (std::max)(render.peakBytesUploaded, recorded.bytesUploaded);
+    }
+}
+
+void BenchmarkRunner::SetUpScenario(MainState& state, Scenario scenario) noexcept {
+    auto& rng = state.m_spawn_rng;
+    const auto bounds = state.m_world_bounds;
+    switch(scenario) {
+    case Scenario::Wave50Hard:
+    {
+        state.m_current_wave = 50u;
+        state.StartNewWave(state.m_current_wave++);
+        break;
+    }
+    case Scenario::SmallAsteroids10k:
+    {
+        for(auto i = std::size_t{0u}; i < small_asteroid_count; ++i) {
+            const auto pos = Vector2{rng.GetInRange<float>(bounds.mins.x, bounds.maxs.x), rng.GetInRange<float>(bounds.mins.y, bounds.maxs.y)};
+            const auto vel = Vector2{rng.GetNegOneToOne<float>(), rng.GetNegOneToOne<float>()} * rng.GetInRange<float>(20.0f, 100.0f);
+            state.RequestSpawn(SpawnRequest::ForAsteroid(static_cast<uint8_t>(Asteroid::Type::Small), pos, vel, rng.GetNegOneToOne<float>() * 180.0f));
+        }
+        break;
+    }
+    case Scenario::BossUfoStorm:
+    {
+        for(auto i = std::size_t{0u}; i < boss_ufo_count; ++i) {
+            state.MakeUfo(Ufo::Type::Boss, bounds);
+        }
+        state.StartNewWave(state.m_current_wave++);
+        break;
+    }
+    case Scenario::MassKillAll:
+    {
+        state.StartNewWave(20u);
+        break;
+    }
+    default:
+        break;
+    }
+    //Spawns wait in the queue; commit them before timing starts.
+    state.PostFrameCleanup();
+}
+
+void BenchmarkRunner::StepScenario(MainState& state, Scenario scenario, std::size_t frame) noexcept {
+    if(scenario != Scenario::MassKillAll) {
+        return;
+    }
+    if(frame % kill_all_interval == kill_all_interval - 1u) {
+        state.KillAll();
+    } else if(state.asteroids.empty()) {
+        state.StartNewWave(20u);
+    }
+}
+
+BenchmarkRunner::PhaseStats BenchmarkRunner::Summarize(std::vector<double>& samples_ms) noexcept {
+    PhaseStats stats{};
+    stats.samples = samples_ms.size();
+    if(samples_ms.empty()) {
+        return stats;
+    }
+    std::sort(std::begin(samples_ms), std::end(samples_ms));
+    const auto rank = [&samples_ms](double percentile) {
+        const auto index = static_cast<std::size_t>(std::ceil(percentile * static_cast<double>(samples_ms.size()))) - 1u;
+        return samples_ms[(std::min)(index, samples_ms.size() - 1u)];
+    };
+    stats.min_ms = samples_ms.front();
+    stats.median_ms = rank(0.5);
+    stats.p99_ms = rank(0.99);
+    return stats;
+}
+
+std::string BenchmarkRunner::ToJson(const std::vector<ScenarioResult>& results, const std::vector<IntegrateResult>& integrate, uint64_t seed) noexcept {
+    std::string json = std::format("{{\n  \"seed\": {},\n  \"scenarios\": [\n", seed);
+    for(auto r = std::size_t{0u}; r < results.size(); ++r) {
+        const auto& result = results[r];
+        json += std::format("    {{\n      \"name\": \"{}\",\n      \"frames\": {},\n      \"peak_entities\": {},\n      \"phases\": {{\n", GetScenarioName(result.scenario), result.frames, result.peakEntities);
+        for(auto p = std::size_t{0u}; p < phase_count; ++p) {
+            const auto& stats = result.phases[p];
+            json += std::format("        \"{}\": {{ \"samples\": {}, \"min_ms\": {:.4f}, \"median_ms\": {:.4f}, \"p99_ms\": {:.4f} }}{}\n", GetPhaseName(p), stats.samples, stats.min_ms, stats.median_ms, stats.p99_ms, p + 1u < phase_count ? "," : "");
+        }
+        json += "      },\n      \"sprite_state\": {\n";
+        for(auto m = std::size_t{0u}; m < state_mode_count; ++m) {
+            const auto& mode = result.spriteState[m];
+            const auto& stats = mode.build;
+            const auto& render = mode.render;
+            json += std::format("        \"{}\": {{ \"peak_draws\": {}, \"peak_state_uploads\": {}, \"samples\": {}, \"min_ms\": {:.4f}, \"median_ms\": {:.4f}, \"p99_ms\": {:.4f},\n", GetStateModeName(m), mode.peakDraws, mode.peakStateUploads, stats.samples, stats.min_ms, stats.median_ms, stats.p99_ms);
+            json += std::format("          \"render\": {{ \"mean_draws\": {:.2f}, \"peak_draws\": {}, \"mean_state_changes\": {:.2f}, \"peak_state_changes\": {}, \"mean_bytes_uploaded\": {:.1f}, \"peak_bytes_uploaded\": {} }} }}{}\n", render.meanDraws, render.peakDraws, render.meanStateChanges, render.peakStateChanges, render.meanBytesUploaded, render.peakBytesUploaded, m + 1u < state_mode_count ? "," : "");
+        }
+        json += std::format("      }}\n    }}{}\n", r + 1u < results.size() ? "," : "");
+    }
+    json += "  ],\n  \"integrate\": [\n";
+    for(auto i = std::size_t{0u}; i < integrate.size(); ++i) {
+        const auto& result = integrate[i];
+        json += std::format("    {{ \"slots\": {}, \"max_relative_error\": {:.3e}, \"within_tolerance\": {}, \"pending_untouched\": {},\n", result.slots, result.maxRelativeError, result.withinTolerance, result.pendingUntouched);
+        json += std::format("      \"batched\": {{ \"samples\": {}, \"min_ms\": {:.4f}, \"median_ms\": {:.4f}, \"p99_ms\": {:.4f} }},\n", result.batched.samples, result.batched.min_ms, result.batched.median_ms, result.batched.p99_ms);
+        json += std::format("      \"per_entity\": {{ \"samples\": {}, \"min_ms\": {:.4f}, \"median_ms\": {:.4f}, \"p99_ms\": {:.4f} }} }}{}\n", result.perEntity.samples, result.perEntity.min_ms, result.perEntity.median_ms, result.perEntity.p99_ms, i + 1u < integrate.size() ? "," : "");
+    }
+    json += "  ]\n}\n";
+    return json;
+}
+
+std::string BenchmarkRunner::ToCsv(const std::vector<ScenarioResult>& results, const std::vector<IntegrateResult>& integrate) noexcept {
+    std::string csv = "scenario,phase,samples,min_ms,median_ms,p99_ms\n";
+    for(const auto& result : results) {
+        for(auto p = std::size_t{0u}; p < phase_count; ++p) {
+            const auto& stats = result.phases[p];
+            csv += std::format("{},{},{},{:.4f},{:.4f},{:.4f}\n", GetScenarioName(result.scenario), GetPhaseName(p), stats.samples, stats.min_ms, stats.median_ms, stats.p99_ms);
+        }
+        for(auto m = std::size_t{0u}; m < state_mode_count; ++m) {
+            const auto& stats = result.spriteState[m].build;
+            csv += std::format("{},sprite_state_{},{},{:.4f},{:.4f},{:.4f}\n", GetScenarioName(result.scenario), GetStateModeName(m), stats.samples, stats.min_ms, stats.median_ms, stats.p99_ms);
+        }
+    }
+    for(const auto& result : integrate) {
+        csv += std::format("{}_{},batched,{},{:.4f},{:.4f},{:.4f}\n", integrate_scenario_name, result.slots, result.batched.samples, result.batched.min_ms, result.batched.median_ms, result.batched.p99_ms);
+        csv += std::format("{}_{},per_entity,{},{:.4f},{:.4f},{:.4f}\n", integrate_scenario_name, result.slots, result.perEntity.samples, result.perEntity.min_ms, result.perEntity.median_ms, result.perEntity.p99_ms);
+    }
+    return csv;
+}
+
+std::string_view BenchmarkRunner::GetScenarioName(Scenario scenario) noexcept {
+    switch(scenario) {
+    case Scenario::Wave50Hard: return "wave50_hard";
+    case Scenario::SmallAsteroids10k: return "small_asteroids_10k";
+    case Scenario::BossUfoStorm: return "boss_ufo_storm";
+    case Scenario::MassKillAll: return "mass_kill_all";
+    default: return "unknown";
+    }
+}
+
+std::string_view BenchmarkRunner::GetPhaseName(std::size_t phase) noexcept {
+    switch(static_cast<MainState::FramePhase>(phase)) {
+    case MainState::FramePhase::Update: return "update_entities";
+    case MainState::FramePhase::Broadphase: return "broadphase";
+    case MainState::FramePhase::BulletCollision: return "bullet_collision";
+    case MainState::FramePhase::ShipCollision: return "ship_collision";
+    case MainState::FramePhase::MineCollision: return "mine_collision";
+    case MainState::FramePhase::Cleanup: return "post_frame_cleanup";
+    case MainState::FramePhase::RenderBuild: return "render_build";
+    case MainState::FramePhase::Max: return "frame";
+    default: return "unknown";
+    }
+}
+
+std::string_view BenchmarkRunner::GetStateModeName(std::size_t mode) noexcept {
+    switch(static_cast<SpriteBatch::StateMode>(mode)) {
+    case SpriteBatch::StateMode::ConstantBuffer: return "constant_buffer";
+    case SpriteBatch::StateMode::Vertex: return "vertex";
+    default: return "unknown";
+    }
+}
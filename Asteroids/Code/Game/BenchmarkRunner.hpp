@@ -0,0 +1,125 @@
+#pragma once
+
+#include "Engine/Core/TimeUtils.hpp"
+
+#include "Game/MainState.hpp"
+#include "Game/RecordingRenderBackend.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/SpriteBatch.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Game;
+
+//Builds scripted stress scenarios on a fresh MainState and times every frame
+//phase. Results are summarized per phase as min, median and p99 so builds can
+//be compared from the JSON or CSV output. Each frame is also batched once per
+//SpriteBatch::StateMode and replayed through a RecordingRenderBackend, so the
+//two ways of feeding sprite state to the shader and the draw calls, state
+//changes and bytes uploaded per frame can be compared without a device.
+//Benchmarks always run headless and never render, so the render_build phase
+//is the capture and batching time of SpriteBatch's default mode, taken after
+//the frame and not part of the frame total.
+//The "integrate" scenario times KinematicsStore's batched pass, Integrate and
+//CalcTransforms, against the per-entity update and SRT matrix product it
+//replaced, on the same random slots, and checks that they agree.
+class BenchmarkRunner {
+public:
+    enum class Scenario : uint8_t {
+        Wave50Hard
+        , SmallAsteroids10k
+        , BossUfoStorm
+        , MassKillAll
+        , Max
+    };
+
+    struct Options {
+        std::size_t warmupFrames{30u};
+        std::size_t frames{600u};
+        TimeUtils::FPSeconds frameDuration{1.0f / 60.0f};
+        //A scenario name, or "all".
+        std::string scenario{"all"};
+    };
+
+    struct PhaseStats {
+        std::size_t samples{0u};
+        double min_ms{0.0};
+        double median_ms{0.0};
+        double p99_ms{0.0};
+    };
+
+    //One entry per MainState::FramePhase followed by the whole frame.
+    static inline constexpr const std::size_t phase_count = static_cast<std::size_t>(MainState::FramePhase::Max) + 1u;
+
+    static inline constexpr const std::size_t state_mode_count = static_cast<std::size_t>(SpriteBatch::StateMode::Max);
+
+    //Per frame, as replayed through RecordingRenderBackend.
+    struct RenderPathStats {
+        double meanDraws{0.0};
+        std::size_t peakDraws{0u};
+        double meanStateChanges{0.0};
+        std::size_t peakStateChanges{0u};
+        double meanBytesUploaded{0.0};
+        std::size_t peakBytesUploaded{0u};
+    };
+
+    struct SpriteStateStats {
+        PhaseStats build{};
+        std::size_t peakDraws{0u};
+        std::size_t peakStateUploads{0u};
+        RenderPathStats render{};
+    };
+
+    struct IntegrateResult {
+        std::size_t slots{0u};
+        PhaseStats batched{};
+        PhaseStats perEntity{};
+        float maxRelativeError{0.0f};
+        bool withinTolerance{false};
+        //Pending slots queued behind the committed ones came out untouched.
+        bool pendingUntouched{false};
+    };
+
+    static inline constexpr const std::string_view integrate_scenario_name{"integrate"};
+    static inline constexpr const std::array<std::size_t, 3> integrate_slot_counts{1'000u, 10'000u, 100'000u};
+    static inline constexpr const std::size_t integrate_pending_slots{5u};
+    static inline constexpr const float integrate_tolerance{1e-5f};
+
+    struct ScenarioResult {
+        Scenario scenario{Scenario::Max};
+        std::size_t frames{0u};
+        std::size_t peakEntities{0u};
+        std::array<PhaseStats, phase_count> phases{};
+        std::array<SpriteStateStats, state_mode_count> spriteState{};
+    };
+
+    explicit BenchmarkRunner(const Options& options) noexcept;
+
+    [[nodiscard]] std::vector<ScenarioResult> Run(Game& game) noexcept;
+    //Needs no game, only the seed for the slot values.
+    [[nodiscard]] std::vector<IntegrateResult> RunIntegrate(uint64_t seed) const noexcept;
+
+    [[nodiscard]] static std::string ToJson(const std::vector<ScenarioResult>& results, const std::vector<IntegrateResult>& integrate, uint64_t seed) noexcept;
+    [[nodiscard]] static std::string ToCsv(const std::vector<ScenarioResult>& results, const std::vector<IntegrateResult>& integrate) noexcept;
+
+    [[nodiscard]] static std::string_view GetScenarioName(Scenario scenario) noexcept;
+    [[nodiscard]] static std::string_view GetPhaseName(std::size_t phase) noexcept;
+    [[nodiscard]] static std::string_view GetStateModeName(std::size_t mode) noexcept;
+
+protected:
+private:
+    [[nodiscard]] ScenarioResult RunScenario(Game& game, Scenario scenario) noexcept;
+    void SetUpScenario(MainState& state, Scenario scenario) noexcept;
+    void StepScenario(MainState& state, Scenario scenario, std::size_t frame) noexcept;
+    [[nodiscard]] IntegrateResult RunIntegrateSlots(uint64_t seed, std::size_t slots) const noexcept;
+    void RecordSpriteStateModes(const MainState& state, std::array<std::vector<double>, state_mode_count>& samples, ScenarioResult& result) noexcept;
+    [[nodiscard]] static PhaseStats Summarize(std::vector<double>& samples_ms) noexcept;
+
+    Options m_options{};
+    RenderSnapshot m_state_mode_snapshot{};
+    RecordingRenderBackend m_recorder{};
+};
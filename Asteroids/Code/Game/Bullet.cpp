@@ -11,18 +11,42 @@
 
 #include "Engine/Scene/Components.hpp"
 
+#include "Engine/Services/ServiceLocator.hpp"
+#include "Engine/Services/IAudioService.hpp"
+#include "Engine/Services/IRendererService.hpp"
+
+#include "Game/EntityPool.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/GameConfig.hpp"
 #include "Game/Game.hpp"
 
 #include <algorithm>
 
+namespace {
+
+EntityPool<Bullet, 256>& GetBulletPool() noexcept {
+    static EntityPool<Bullet, 256> pool{};
+    return pool;
+}
+
+}
+
+void* Bullet::operator new(std::size_t size) {
+    return GetBulletPool().Allocate(size);
+}
+
+void Bullet::operator delete(void* ptr, std::size_t size) noexcept {
+    GetBulletPool().Deallocate(ptr, size);
+}
+
 Bullet::Bullet(std::weak_ptr<Scene> scene, const GameEntity* parent, Vector2 position, Vector2 velocity) noexcept
 : GameEntity(scene.lock()->CreateEntity(), scene, parent)
 {
     UpdateComponent<TransformComponent>(Matrix4::CreateTranslationMatrix(position));
 
     faction = m_gameParent->faction;
+    kind = GameEntity::Kind::Bullet;
+    m_material = GetGameAs<Game>()->materials.bullet;
     SetPosition(position);
     SetVelocity(velocity);
     SetCosmeticRadius(15.0f);
@@ -50,39 +74,13 @@ void Bullet::Update(TimeUtils::FPSeconds deltaSeconds) noexcept {
         return;
     }
 
-    const auto pos = GetPosition();
-    const auto uvs = AABB2::Zero_to_One;
-    const auto mat = GetMaterial();
-    const auto tex = mat->GetTexture(Material::TextureID::Diffuse);
-    const auto frameWidth = static_cast<float>(tex->GetDimensions().x);
-    const auto frameHeight = static_cast<float>(tex->GetDimensions().y);
-    const auto half_extents = Vector2{frameWidth, frameHeight} *0.5f;
-    {
-        const auto S = Matrix4::CreateScaleMatrix(half_extents);
-        const auto R = Matrix4::Create2DRotationDegreesMatrix(GetOrientationDegrees());
-        const auto T = Matrix4::CreateTranslationMatrix(GetPosition());
-        UpdateComponent<TransformComponent>(Matrix4::MakeSRT(S, R, T));
-    }
-
-    auto& builder = m_mesh_builder;
-    builder.Begin(PrimitiveType::Triangles);
-    builder.SetColor(Rgba::White);
-
-    builder.SetUV(Vector2{uvs.maxs.x, uvs.maxs.y});
-    builder.AddVertex(Vector2{+0.5f, +0.5f});
-
-    builder.SetUV(Vector2{uvs.mins.x, uvs.maxs.y});
-    builder.AddVertex(Vector2{-0.5f, +0.5f});
-
-    builder.SetUV(Vector2{uvs.mins.x, uvs.mins.y});
-    builder.AddVertex(Vector2{-0.5f, -0.5f});
-
-    builder.SetUV(Vector2{uvs.maxs.x, uvs.mins.y});
-    builder.AddVertex(Vector2{+0.5f, -0.5f});
-
-    builder.AddIndicies(Mesh::Builder::Primitive::Quad);
-    builder.End(mat);
+    const auto half_extents = GetMaterialDimensions() * 0.5f;
+    UpdateTransform(half_extents);
+}
 
+bool Bullet::AppendToSpriteBatch(SpriteBatch& batch) const noexcept {
+    batch.Add(m_material, MakeSpriteInstance(AABB2::Zero_to_One));
+    return true;
 }
 
 void Bullet::EndFrame() noexcept {
@@ -93,10 +91,6 @@ void Bullet::OnDestroy() noexcept {
     GameEntity::OnDestroy();
 }
 
-Material* Bullet::GetMaterial() const noexcept {
-    return g_theRenderer->GetMaterial("bullet");
-}
-
 void Bullet::OnFire() noexcept {
     /* DO NOTHING */
 }
@@ -106,8 +100,8 @@ void Bullet::OnCollision(GameEntity* /*a*/, GameEntity* /*b*/) noexcept {
 }
 
 void Bullet::OnCreate() noexcept {
-    AudioSystem::SoundDesc desc{};
-    desc.groupName = g_audiogroup_sound;
-    g_theAudioSystem->Play(g_sound_shootpath, desc);
+    if(auto* game = GetGameAs<Game>(); game != nullptr) {
+        game->GetAudio().Play(game->sounds.shoot);
+    }
 }
 
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Engine/Core/Stopwatch.hpp"
+#include "Game/SimStopwatch.hpp"
 #include "Engine/Core/TimeUtils.hpp"
 
 #include "Engine/Math/Vector2.hpp"
@@ -9,6 +9,7 @@
 
 #include "Game/GameEntity.hpp"
 
+#include <cstddef>
 #include <memory>
 
 class Renderer;
@@ -17,7 +18,11 @@ class Bullet : public GameEntity {
 public:
     explicit Bullet(std::weak_ptr<Scene> scene, const GameEntity* parent, Vector2 position, Vector2 velocity) noexcept;
     virtual ~Bullet() = default;
+
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size) noexcept;
     void Update(TimeUtils::FPSeconds deltaSeconds) noexcept override;
+    bool AppendToSpriteBatch(SpriteBatch& batch) const noexcept override;
     void EndFrame() noexcept override;
 
     void OnCreate() noexcept override;
@@ -25,9 +30,8 @@ public:
     void OnCollision(GameEntity* a, GameEntity* b) noexcept override;
     void OnDestroy() noexcept override;
 
-    Material* GetMaterial() const noexcept override;
 private:
     float CalculateTtlFromDifficulty() const noexcept;
-    Stopwatch ttl{};
+    SimStopwatch ttl{};
 };
 
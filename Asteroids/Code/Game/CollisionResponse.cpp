@@ -0,0 +1,42 @@
+#include "Game/CollisionResponse.hpp"
+
+#include "Game/Asteroid.hpp"
+#include "Game/Bullet.hpp"
+#include "Game/Mine.hpp"
+#include "Game/Ship.hpp"
+#include "Game/Ufo.hpp"
+
+namespace CollisionResponse {
+
+void Dispatch(GameEntity& a, GameEntity& b) noexcept {
+    switch(GetResponse(a.faction, a.kind, b.faction, b.kind)) {
+    case Response::AsteroidHitByBullet:
+        static_cast<Asteroid&>(a).OnHitBy(static_cast<Bullet&>(b));
+        break;
+    case Response::AsteroidHitByMine:
+        static_cast<Asteroid&>(a).OnHitBy(static_cast<Mine&>(b));
+        break;
+    case Response::UfoHitByBullet:
+        static_cast<Ufo&>(a).OnHitBy(static_cast<Bullet&>(b));
+        break;
+    case Response::UfoHitByMine:
+        static_cast<Ufo&>(a).OnHitBy(static_cast<Mine&>(b));
+        break;
+    case Response::ShipHitByBullet:
+        static_cast<Ship&>(a).OnHitBy(static_cast<Bullet&>(b));
+        break;
+    case Response::ShipHitByUfo:
+        static_cast<Ship&>(a).OnHitBy(static_cast<Ufo&>(b));
+        break;
+    case Response::ShipHitByAsteroid:
+        static_cast<Ship&>(a).OnHitBy(static_cast<Asteroid&>(b));
+        break;
+    case Response::None:
+        /* DO NOTHING */
+        break;
+    default:
+        break;
+    }
+}
+
+} // namespace CollisionResponse
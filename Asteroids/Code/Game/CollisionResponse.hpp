@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Game/GameEntity.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+//Compile-time table of how a (faction, kind) pair responds to being touched
+//by another (faction, kind) pair. The collision stage routes contacts through
+//it instead of testing the runtime type of each participant, and the broadphase
+//uses it to skip pair categories that can never produce a response.
+namespace CollisionResponse {
+
+enum class Response : uint8_t {
+    None
+    , AsteroidHitByBullet
+    , AsteroidHitByMine
+    , UfoHitByBullet
+    , UfoHitByMine
+    , ShipHitByBullet
+    , ShipHitByUfo
+    , ShipHitByAsteroid
+};
+
+namespace detail {
+
+static inline constexpr const std::size_t faction_count = static_cast<std::size_t>(GameEntity::Faction::Max);
+static inline constexpr const std::size_t kind_count = static_cast<std::size_t>(GameEntity::Kind::Max);
+static inline constexpr const std::size_t category_count = faction_count * kind_count;
+
+[[nodiscard]] constexpr std::size_t CalcCategory(GameEntity::Faction faction, GameEntity::Kind kind) noexcept {
+    return static_cast<std::size_t>(faction) * kind_count + static_cast<std::size_t>(kind);
+}
+
+using table_type = std::array<Response, category_count * category_count>;
+
+[[nodiscard]] constexpr table_type MakeTable() noexcept {
+    using F = GameEntity::Faction;
+    using K = GameEntity::Kind;
+    table_type table{};
+    const auto set = [&table](F fa, K ka, F fb, K kb, Response response) {
+        table[CalcCategory(fa, ka) * category_count + CalcCategory(fb, kb)] = response;
+    };
+    set(F::Asteroid, K::Asteroid, F::Player, K::Bullet, Response::AsteroidHitByBullet);
+    set(F::Asteroid, K::Asteroid, F::Player, K::Mine, Response::AsteroidHitByMine);
+    set(F::Enemy, K::Ufo, F::Player, K::Bullet, Response::UfoHitByBullet);
+    set(F::Enemy, K::Ufo, F::Player, K::Mine, Response::UfoHitByMine);
+    set(F::Player, K::Ship, F::Enemy, K::Bullet, Response::ShipHitByBullet);
+    set(F::Player, K::Ship, F::Enemy, K::Ufo, Response::ShipHitByUfo);
+    set(F::Player, K::Ship, F::Asteroid, K::Asteroid, Response::ShipHitByAsteroid);
+    return table;
+}
+
+static inline constexpr const table_type table = MakeTable();
+
+} // namespace detail
+
+[[nodiscard]] constexpr Response GetResponse(GameEntity::Faction fa, GameEntity::Kind ka, GameEntity::Faction fb, GameEntity::Kind kb) noexcept {
+    return detail::table[detail::CalcCategory(fa, ka) * detail::category_count + detail::CalcCategory(fb, kb)];
+}
+
+[[nodiscard]] constexpr bool CanInteract(GameEntity::Faction fa, GameEntity::Kind ka, GameEntity::Faction fb, GameEntity::Kind kb) noexcept {
+    return GetResponse(fa, ka, fb, kb) != Response::None || GetResponse(fb, kb, fa, ka) != Response::None;
+}
+
+[[nodiscard]] inline bool CanInteract(const GameEntity& a, const GameEntity& b) noexcept {
+    return CanInteract(a.faction, a.kind, b.faction, b.kind);
+}
+
+//Applies the response of a to being touched by b.
+void Dispatch(GameEntity& a, GameEntity& b) noexcept;
+
+} // namespace CollisionResponse
@@ -0,0 +1,48 @@
+#include "Game/ContactSet.hpp"
+
+#include "Game/GameEntity.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+void ContactSet::Begin(std::size_t chunkCount) noexcept {
+    //Chunks beyond chunkCount keep their capacity for later frames.
+    if(m_chunks.size() < chunkCount) {
+        m_chunks.resize(chunkCount);
+    }
+    for(std::size_t i = 0u; i < chunkCount; ++i) {
+        m_chunks[i].contacts.clear();
+        m_chunks[i].pairTests = 0u;
+    }
+    m_chunk_count = chunkCount;
+    m_merged.clear();
+}
+
+void ContactSet::Add(std::size_t chunk, GameEntity& a, GameEntity& b) noexcept {
+    m_chunks[chunk].contacts.push_back(Contact{&a, &b, a.GetSpawnId(), b.GetSpawnId()});
+}
+
+void ContactSet::AddPairTests(std::size_t chunk, std::size_t count) noexcept {
+    m_chunks[chunk].pairTests += count;
+}
+
+const std::vector<ContactSet::Contact>& ContactSet::Merge() noexcept {
+    m_merged.clear();
+    for(std::size_t i = 0u; i < m_chunk_count; ++i) {
+        const auto& contacts = m_chunks[i].contacts;
+        m_merged.insert(std::end(m_merged), std::cbegin(contacts), std::cend(contacts));
+    }
+    //Spawn ids are unique, so the order is total and no two runs can disagree.
+    std::sort(std::begin(m_merged), std::end(m_merged), [](const Contact& lhs, const Contact& rhs) {
+        return lhs.aSpawnId != rhs.aSpawnId ? lhs.aSpawnId < rhs.aSpawnId : lhs.bSpawnId < rhs.bSpawnId;
+    });
+    return m_merged;
+}
+
+std::size_t ContactSet::GetPairTestCount() const noexcept {
+    std::size_t total = 0u;
+    for(std::size_t i = 0u; i < m_chunk_count; ++i) {
+        total += m_chunks[i].pairTests;
+    }
+    return total;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class GameEntity;
+
+//Contacts found by a parallel narrowphase. Each chunk of the detect pass
+//writes to its own list, so detection never touches an entity or shares a
+//buffer. Merge gathers the lists and sorts the contacts by the spawn ids of
+//both participants, so responses are applied in the same order whatever the
+//thread count or iteration order was.
+class ContactSet {
+public:
+    struct Contact {
+        //The entity that responds, and the one that touched it.
+        GameEntity* a{nullptr};
+        GameEntity* b{nullptr};
+        uint64_t aSpawnId{0u};
+        uint64_t bSpawnId{0u};
+    };
+
+    ContactSet() noexcept = default;
+    ContactSet(const ContactSet& other) = delete;
+    ContactSet(ContactSet&& other) = delete;
+    ContactSet& operator=(const ContactSet& other) = delete;
+    ContactSet& operator=(ContactSet&& other) = delete;
+    ~ContactSet() noexcept = default;
+
+    //Empties every list and makes room for chunkCount of them.
+    void Begin(std::size_t chunkCount) noexcept;
+    //Only ever called by the job running chunk.
+    void Add(std::size_t chunk, GameEntity& a, GameEntity& b) noexcept;
+    void AddPairTests(std::size_t chunk, std::size_t count) noexcept;
+    //Appends every chunk's contacts since the last Begin and sorts them.
+    [[nodiscard]] const std::vector<Contact>& Merge() noexcept;
+
+    [[nodiscard]] std::size_t GetPairTestCount() const noexcept;
+
+protected:
+private:
+    struct Chunk {
+        std::vector<Contact> contacts{};
+        std::size_t pairTests{0u};
+    };
+
+    std::vector<Chunk> m_chunks{};
+    std::size_t m_chunk_count{0u};
+    std::vector<Contact> m_merged{};
+};
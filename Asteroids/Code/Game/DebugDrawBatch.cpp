@@ -0,0 +1,101 @@
+#include "Game/DebugDrawBatch.hpp"
+
+#include "Engine/Math/MathUtils.hpp"
+
+#include <cmath>
+
+namespace {
+
+using UnitCircle = std::array<Vector2, DebugDrawBatch::circle_segments>;
+
+[[nodiscard]] const UnitCircle& GetUnitCircle() noexcept {
+    static const auto circle = []() {
+        UnitCircle result{};
+        for(std::size_t i = 0u; i < result.size(); ++i) {
+            const auto radians = MathUtils::M_2PI * static_cast<float>(i) / static_cast<float>(result.size());
+            result[i] = Vector2{std::cos(radians), std::sin(radians)};
+        }
+        return result;
+    }(); //IIIL
+    return circle;
+}
+
+} // namespace
+
+DebugDrawBatch::DebugDrawBatch() noexcept {
+    m_enabled.fill(true);
+}
+
+void DebugDrawBatch::Begin() noexcept {
+    m_lines.Clear();
+    m_lines.Begin(PrimitiveType::Lines);
+    m_line_count = 0u;
+    m_has_material = false;
+}
+
+void DebugDrawBatch::AddLine(Category category, const Vector2& start, const Vector2& end, const Rgba& color) noexcept {
+    if(!IsEnabled(category)) {
+        return;
+    }
+    AppendLine(start, end, color);
+}
+
+void DebugDrawBatch::AddCircle(Category category, const Vector2& center, float radius, const Rgba& color) noexcept {
+    if(!IsEnabled(category)) {
+        return;
+    }
+    const auto& circle = GetUnitCircle();
+    for(std::size_t i = 0u; i < circle.size(); ++i) {
+        const auto& a = circle[i];
+        const auto& b = circle[(i + 1u) % circle.size()];
+        AppendLine(center + a * radius, center + b * radius, color);
+    }
+}
+
+void DebugDrawBatch::AddAABB2(Category category, const AABB2& bounds, const Rgba& color) noexcept {
+    if(!IsEnabled(category)) {
+        return;
+    }
+    const auto top_left = Vector2{bounds.mins.x, bounds.maxs.y};
+    const auto bottom_right = Vector2{bounds.maxs.x, bounds.mins.y};
+    AppendLine(bounds.mins, top_left, color);
+    AppendLine(top_left, bounds.maxs, color);
+    AppendLine(bounds.maxs, bottom_right, color);
+    AppendLine(bottom_right, bounds.mins, color);
+}
+
+void DebugDrawBatch::End(Material* material) noexcept {
+    m_lines.End(material);
+    m_has_material = material != nullptr;
+}
+
+void DebugDrawBatch::Render() const noexcept {
+    if(!m_has_material || m_line_count == 0u) {
+        return;
+    }
+    Mesh::Render(m_lines);
+}
+
+void DebugDrawBatch::SetEnabled(Category category, bool enabled) noexcept {
+    m_enabled[static_cast<std::size_t>(category)] = enabled;
+}
+
+void DebugDrawBatch::Toggle(Category category) noexcept {
+    SetEnabled(category, !IsEnabled(category));
+}
+
+bool DebugDrawBatch::IsEnabled(Category category) const noexcept {
+    return m_enabled[static_cast<std::size_t>(category)];
+}
+
+std::size_t DebugDrawBatch::GetLineCount() const noexcept {
+    return m_line_count;
+}
+
+void DebugDrawBatch::AppendLine(const Vector2& start, const Vector2& end, const Rgba& color) noexcept {
+    m_lines.SetColor(color);
+    m_lines.AddVertex(start);
+    m_lines.AddVertex(end);
+    m_lines.AddIndicies(Mesh::Builder::Primitive::Line);
+    ++m_line_count;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Engine/Core/Rgba.hpp"
+
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Vector2.hpp"
+
+#include "Engine/Renderer/Mesh.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class Material;
+
+//Immediate-mode debug shapes for one frame. Circles and boxes are turned into
+//line segments as they are added, so the whole frame is a single line-list
+//stream drawn with one material switch and one draw call. Each shape belongs
+//to a category that can be switched off on its own; disabled shapes are dropped
+//before any vertices are written.
+class DebugDrawBatch {
+public:
+    enum class Category : uint8_t {
+        //Cosmetic and physical radii.
+        Radii
+        //Facing, velocity and acceleration.
+        , Motion
+        , Camera
+        //World, ortho, view and cull rectangles.
+        , Bounds
+        , Max
+    };
+
+    static inline constexpr const std::size_t circle_segments = 32u;
+
+    DebugDrawBatch() noexcept;
+    DebugDrawBatch(const DebugDrawBatch& other) = delete;
+    DebugDrawBatch(DebugDrawBatch&& other) = delete;
+    DebugDrawBatch& operator=(const DebugDrawBatch& other) = delete;
+    DebugDrawBatch& operator=(DebugDrawBatch&& other) = delete;
+    ~DebugDrawBatch() noexcept = default;
+
+    void Begin() noexcept;
+    void AddLine(Category category, const Vector2& start, const Vector2& end, const Rgba& color) noexcept;
+    void AddCircle(Category category, const Vector2& center, float radius, const Rgba& color) noexcept;
+    void AddAABB2(Category category, const AABB2& bounds, const Rgba& color) noexcept;
+    void End(Material* material) noexcept;
+    //Draws in world space; the caller sets the camera and model matrix.
+    void Render() const noexcept;
+
+    void SetEnabled(Category category, bool enabled) noexcept;
+    void Toggle(Category category) noexcept;
+    [[nodiscard]] bool IsEnabled(Category category) const noexcept;
+
+    [[nodiscard]] std::size_t GetLineCount() const noexcept;
+
+protected:
+private:
+    void AppendLine(const Vector2& start, const Vector2& end, const Rgba& color) noexcept;
+
+    Mesh::Builder m_lines{};
+    std::array<bool, static_cast<std::size_t>(Category::Max)> m_enabled{};
+    std::size_t m_line_count{0u};
+    bool m_has_material{false};
+};
@@ -0,0 +1,45 @@
+#include "Game/DeviceAudioBackend.hpp"
+
+#include "Engine/Services/ServiceLocator.hpp"
+#include "Engine/Services/IAudioService.hpp"
+
+#include "Game/GameConfig.hpp"
+
+void DeviceAudioBackend::Load(SoundHandle sound, const std::filesystem::path& path, bool looping) noexcept {
+    if(!sound.IsValid()) {
+        return;
+    }
+    if(m_entries.size() <= sound.index) {
+        m_entries.resize(sound.index + 1u);
+    }
+    auto& entry = m_entries[sound.index];
+    entry.sound = ServiceLocator::get<IAudioService>()->CreateSound(path);
+    entry.desc = AudioSystem::SoundDesc{};
+    entry.desc.groupName = g_audiogroup_sound;
+    if(looping) {
+        entry.desc.loopCount = -1;
+    }
+}
+
+void DeviceAudioBackend::Play(SoundHandle sound, float volume) noexcept {
+    if(auto* entry = GetEntry(sound); entry != nullptr) {
+        auto desc = entry->desc;
+        desc.volume = volume;
+        ServiceLocator::get<IAudioService>()->Play(*entry->sound, desc);
+    }
+}
+
+void DeviceAudioBackend::Stop(SoundHandle sound) noexcept {
+    if(auto* entry = GetEntry(sound); entry != nullptr) {
+        for(auto* channel : entry->sound->GetChannels()) {
+            channel->Stop();
+        }
+    }
+}
+
+DeviceAudioBackend::Entry* DeviceAudioBackend::GetEntry(SoundHandle sound) noexcept {
+    if(!sound.IsValid() || m_entries.size() <= sound.index || m_entries[sound.index].sound == nullptr) {
+        return nullptr;
+    }
+    return &m_entries[sound.index];
+}
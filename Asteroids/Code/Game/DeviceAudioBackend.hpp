@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Engine/Audio/AudioSystem.hpp"
+
+#include "Game/IAudioBackend.hpp"
+
+#include <vector>
+
+//Forwards to the audio service. Commands for sounds that did not load are dropped.
+class DeviceAudioBackend : public IAudioBackend {
+public:
+    virtual ~DeviceAudioBackend() noexcept = default;
+
+    void Load(SoundHandle sound, const std::filesystem::path& path, bool looping) noexcept override;
+    void Play(SoundHandle sound, float volume) noexcept override;
+    void Stop(SoundHandle sound) noexcept override;
+
+protected:
+private:
+    struct Entry {
+        AudioSystem::Sound* sound{nullptr};
+        AudioSystem::SoundDesc desc{};
+    };
+
+    [[nodiscard]] Entry* GetEntry(SoundHandle sound) noexcept;
+
+    std::vector<Entry> m_entries{};
+};
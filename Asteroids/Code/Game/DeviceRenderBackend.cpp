@@ -0,0 +1,32 @@
+#include "Game/DeviceRenderBackend.hpp"
+
+#include "Engine/Renderer/ConstantBuffer.hpp"
+#include "Engine/Renderer/Material.hpp"
+#include "Engine/Renderer/Shader.hpp"
+
+#include "Engine/Services/ServiceLocator.hpp"
+#include "Engine/Services/IRendererService.hpp"
+
+#include "Game/GameEntity.hpp"
+
+void DeviceRenderBackend::SetModelMatrix(const Matrix4& transform) noexcept {
+    ServiceLocator::get<IRendererService>()->SetModelMatrix(transform);
+}
+
+void DeviceRenderBackend::UpdateConstants(MaterialHandle material, const void* data, [[maybe_unused]] std::size_t byteCount) noexcept {
+    auto* resolved = GameEntity::GetMaterialRegistry().GetMaterial(material);
+    if(resolved == nullptr) {
+        return;
+    }
+    //The buffer already knows its own size.
+    if(auto cbs = resolved->GetShader()->GetConstantBuffers(); !cbs.empty()) {
+        cbs[0].get().Update(*ServiceLocator::get<IRendererService>()->GetDeviceContext(), data);
+    }
+}
+
+void DeviceRenderBackend::DrawMesh(MaterialHandle material, const Mesh::Builder& mesh, [[maybe_unused]] std::size_t vertexCount, [[maybe_unused]] std::size_t indexCount) noexcept {
+    if(GameEntity::GetMaterialRegistry().GetMaterial(material) == nullptr) {
+        return;
+    }
+    Mesh::Render(mesh);
+}
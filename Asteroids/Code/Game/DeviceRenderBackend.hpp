@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Game/IRenderBackend.hpp"
+
+//Forwards to the renderer service. Commands for materials the registry
+//cannot resolve are dropped.
+class DeviceRenderBackend : public IRenderBackend {
+public:
+    virtual ~DeviceRenderBackend() noexcept = default;
+
+    void SetModelMatrix(const Matrix4& transform) noexcept override;
+    void UpdateConstants(MaterialHandle material, const void* data, std::size_t byteCount) noexcept override;
+    void DrawMesh(MaterialHandle material, const Mesh::Builder& mesh, std::size_t vertexCount, std::size_t indexCount) noexcept override;
+
+protected:
+private:
+
+};
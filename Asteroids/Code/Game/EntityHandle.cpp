@@ -0,0 +1,38 @@
+#include "Game/EntityHandle.hpp"
+
+EntityHandle EntityHandleTable::Acquire(GameEntity* entity) noexcept {
+    if(m_first_free != EntityHandle::invalid_index) {
+        const auto index = m_first_free;
+        auto& slot = m_slots[index];
+        m_first_free = slot.next_free;
+        slot.entity = entity;
+        slot.next_free = EntityHandle::invalid_index;
+        return EntityHandle{index, slot.generation};
+    }
+    const auto index = static_cast<uint32_t>(m_slots.size());
+    m_slots.push_back(Slot{entity, 0u, EntityHandle::invalid_index});
+    return EntityHandle{index, 0u};
+}
+
+void EntityHandleTable::Release(EntityHandle handle) noexcept {
+    if(!IsAlive(handle)) {
+        return;
+    }
+    auto& slot = m_slots[handle.index];
+    slot.entity = nullptr;
+    ++slot.generation;
+    slot.next_free = m_first_free;
+    m_first_free = handle.index;
+}
+
+GameEntity* EntityHandleTable::Resolve(EntityHandle handle) const noexcept {
+    return IsAlive(handle) ? m_slots[handle.index].entity : nullptr;
+}
+
+bool EntityHandleTable::IsAlive(EntityHandle handle) const noexcept {
+    return handle.IsValid() && handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation && m_slots[handle.index].entity != nullptr;
+}
+
+std::size_t EntityHandleTable::Capacity() const noexcept {
+    return m_slots.size();
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class GameEntity;
+
+//Generational reference to a GameEntity. A handle goes stale as soon as
+//its entity is destroyed, even if the slot is later reused.
+struct EntityHandle {
+    static inline constexpr const uint32_t invalid_index = (std::numeric_limits<uint32_t>::max)();
+
+    uint32_t index{invalid_index};
+    uint32_t generation{0u};
+
+    [[nodiscard]] constexpr bool IsValid() const noexcept {
+        return index != invalid_index;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const EntityHandle& a, const EntityHandle& b) noexcept = default;
+};
+
+//Slot table that hands out EntityHandles with O(1) acquire, release and lookup.
+class EntityHandleTable {
+public:
+    EntityHandleTable() noexcept = default;
+    EntityHandleTable(const EntityHandleTable& other) = delete;
+    EntityHandleTable(EntityHandleTable&& other) = delete;
+    EntityHandleTable& operator=(const EntityHandleTable& other) = delete;
+    EntityHandleTable& operator=(EntityHandleTable&& other) = delete;
+    ~EntityHandleTable() noexcept = default;
+
+    [[nodiscard]] EntityHandle Acquire(GameEntity* entity) noexcept;
+    void Release(EntityHandle handle) noexcept;
+
+    //Returns nullptr if the handle is stale or was never issued.
+    [[nodiscard]] GameEntity* Resolve(EntityHandle handle) const noexcept;
+    [[nodiscard]] bool IsAlive(EntityHandle handle) const noexcept;
+
+    [[nodiscard]] std::size_t Capacity() const noexcept;
+
+protected:
+private:
+    struct Slot {
+        GameEntity* entity{nullptr};
+        uint32_t generation{0u};
+        uint32_t next_free{EntityHandle::invalid_index};
+    };
+    std::vector<Slot> m_slots{};
+    uint32_t m_first_free{EntityHandle::invalid_index};
+};
+
+//Dense list of one entity type addressed by handle. Removal swaps the
+//last element into the vacated position, so iteration order is not stable.
+template<typename T>
+class TypedEntityList {
+public:
+    using iterator = typename std::vector<T*>::iterator;
+    using const_iterator = typename std::vector<T*>::const_iterator;
+
+    void Add(T* entity, EntityHandle handle) noexcept {
+        if(m_dense_position.size() <= handle.index) {
+            m_dense_position.resize(static_cast<std::size_t>(handle.index) + 1u, npos);
+        }
+        m_dense_position[handle.index] = m_items.size();
+        m_items.push_back(entity);
+        m_handles.push_back(handle);
+    }
+
+    bool Remove(EntityHandle handle) noexcept {
+        if(!Contains(handle)) {
+            return false;
+        }
+        const auto position = m_dense_position[handle.index];
+        const auto last = m_items.size() - 1u;
+        if(position != last) {
+            m_items[position] = m_items[last];
+            m_handles[position] = m_handles[last];
+            m_dense_position[m_handles[position].index] = position;
+        }
+        m_items.pop_back();
+        m_handles.pop_back();
+        m_dense_position[handle.index] = npos;
+        return true;
+    }
+
+    [[nodiscard]] bool Contains(EntityHandle handle) const noexcept {
+        if(!handle.IsValid() || m_dense_position.size() <= handle.index) {
+            return false;
+        }
+        const auto position = m_dense_position[handle.index];
+        return position != npos && m_handles[position] == handle;
+    }
+
+    void Reserve(std::size_t count) noexcept {
+        m_items.reserve(count);
+        m_handles.reserve(count);
+    }
+
+    void Clear() noexcept {
+        m_items.clear();
+        m_handles.clear();
+        m_dense_position.clear();
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_items.size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_items.empty(); }
+    [[nodiscard]] T* operator[](std::size_t position) const noexcept { return m_items[position]; }
+    [[nodiscard]] T* back() const noexcept { return m_items.back(); }
+
+    [[nodiscard]] iterator begin() noexcept { return m_items.begin(); }
+    [[nodiscard]] iterator end() noexcept { return m_items.end(); }
+    [[nodiscard]] const_iterator begin() const noexcept { return m_items.begin(); }
+    [[nodiscard]] const_iterator end() const noexcept { return m_items.end(); }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return m_items.cbegin(); }
+    [[nodiscard]] const_iterator cend() const noexcept { return m_items.cend(); }
+
+protected:
+private:
+    static inline constexpr const std::size_t npos = static_cast<std::size_t>(-1);
+    std::vector<T*> m_items{};
+    std::vector<EntityHandle> m_handles{};
+    std::vector<std::size_t> m_dense_position{};
+};
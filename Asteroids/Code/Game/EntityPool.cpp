@@ -0,0 +1,34 @@
+#include "Game/EntityPool.hpp"
+
+#include <algorithm>
+
+EntityPoolBase::EntityPoolBase() noexcept {
+    GetRegistry().push_back(this);
+}
+
+EntityPoolBase::~EntityPoolBase() noexcept {
+    auto& registry = GetRegistry();
+    registry.erase(std::remove(std::begin(registry), std::end(registry), this), std::end(registry));
+}
+
+void EntityPoolBase::RecycleAll() noexcept {
+    for(auto* pool : GetRegistry()) {
+        pool->Recycle();
+    }
+}
+
+EntityPoolBase::Stats EntityPoolBase::GetTotalStats() noexcept {
+    Stats total{};
+    for(const auto* pool : GetRegistry()) {
+        const auto stats = pool->GetStats();
+        total.live += stats.live;
+        total.capacity += stats.capacity;
+        total.heap_fallbacks += stats.heap_fallbacks;
+    }
+    return total;
+}
+
+std::vector<EntityPoolBase*>& EntityPoolBase::GetRegistry() noexcept {
+    static std::vector<EntityPoolBase*> registry{};
+    return registry;
+}
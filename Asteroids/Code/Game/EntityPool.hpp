@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <vector>
+
+//Type-erased interface every EntityPool registers with so MainState can
+//recycle all pools and report their statistics without knowing the types.
+class EntityPoolBase {
+public:
+    struct Stats {
+        std::size_t live{0u};
+        std::size_t capacity{0u};
+        std::size_t heap_fallbacks{0u};
+    };
+
+    EntityPoolBase() noexcept;
+    EntityPoolBase(const EntityPoolBase& other) = delete;
+    EntityPoolBase(EntityPoolBase&& other) = delete;
+    EntityPoolBase& operator=(const EntityPoolBase& other) = delete;
+    EntityPoolBase& operator=(EntityPoolBase&& other) = delete;
+    virtual ~EntityPoolBase() noexcept;
+
+    //Returns blocks released since the last call to the free list.
+    virtual void Recycle() noexcept = 0;
+    [[nodiscard]] virtual Stats GetStats() const noexcept = 0;
+
+    static void RecycleAll() noexcept;
+    [[nodiscard]] static Stats GetTotalStats() noexcept;
+
+protected:
+private:
+    static std::vector<EntityPoolBase*>& GetRegistry() noexcept;
+};
+
+//Fixed-capacity block pool backing a GameEntity subclass's class-level
+//operator new/delete. Released blocks are parked until Recycle so a block
+//is never reused within the frame it was freed in. Requests that do not
+//fit (pool exhausted or a larger derived type) fall back to the heap and
+//are counted.
+template<typename T, std::size_t Capacity>
+class EntityPool : public EntityPoolBase {
+public:
+    EntityPool() noexcept
+        : m_blocks(std::make_unique<Block[]>(Capacity))
+    {
+        m_free.reserve(Capacity);
+        m_released.reserve(Capacity);
+        for(std::size_t i = Capacity; i > 0; --i) {
+            m_free.push_back(&m_blocks[i - 1]);
+        }
+    }
+    virtual ~EntityPool() noexcept = default;
+
+    [[nodiscard]] void* Allocate(std::size_t size) {
+        if(size <= sizeof(Block) && !m_free.empty()) {
+            auto* block = m_free.back();
+            m_free.pop_back();
+            ++m_live;
+            return block;
+        }
+        ++m_heap_fallbacks;
+        return ::operator new(size);
+    }
+
+    void Deallocate(void* ptr, std::size_t size) noexcept {
+        if(!ptr) {
+            return;
+        }
+        if(Owns(ptr)) {
+            m_released.push_back(static_cast<Block*>(ptr));
+            --m_live;
+            return;
+        }
+        ::operator delete(ptr, size);
+    }
+
+    void Recycle() noexcept override {
+        m_free.insert(std::end(m_free), std::begin(m_released), std::end(m_released));
+        m_released.clear();
+    }
+
+    [[nodiscard]] Stats GetStats() const noexcept override {
+        return Stats{m_live, Capacity, m_heap_fallbacks};
+    }
+
+protected:
+private:
+    struct alignas(T) Block {
+        std::byte data[sizeof(T)];
+    };
+
+    [[nodiscard]] bool Owns(const void* ptr) const noexcept {
+        const auto* first = m_blocks.get();
+        const auto* last = first + Capacity;
+        return std::less<const void*>{}(ptr, last) && !std::less<const void*>{}(ptr, first);
+    }
+
+    std::unique_ptr<Block[]> m_blocks{};
+    std::vector<Block*> m_free{};
+    std::vector<Block*> m_released{};
+    std::size_t m_live{0u};
+    std::size_t m_heap_fallbacks{0u};
+};
@@ -9,22 +9,47 @@
 
 #include "Engine/Scene/Components.hpp"
 
+#include "Engine/Services/ServiceLocator.hpp"
+#include "Engine/Services/IAudioService.hpp"
+#include "Engine/Services/IRendererService.hpp"
+
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Game/GameBase.hpp"
 
+#include "Game/EntityPool.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/GameConfig.hpp"
 #include "Game/Game.hpp"
 
 #include <algorithm>
 
+namespace {
+
+EntityPool<Explosion, 128>& GetExplosionPool() noexcept {
+    static EntityPool<Explosion, 128> pool{};
+    return pool;
+}
+
+}
+
+void* Explosion::operator new(std::size_t size) {
+    return GetExplosionPool().Allocate(size);
+}
+
+void Explosion::operator delete(void* ptr, std::size_t size) noexcept {
+    GetExplosionPool().Deallocate(ptr, size);
+}
+
 Explosion::Explosion(std::weak_ptr<Scene> scene, Vector2 position)
 : GameEntity(scene.lock()->CreateEntity(), scene)
 {
     UpdateComponent<TransformComponent>(Matrix4::CreateTranslationMatrix(position));
+    kind = GameEntity::Kind::Explosion;
+    m_material = GetGameAs<Game>()->materials.explosion;
 
+    auto* rs = ServiceLocator::get<IRendererService>();
     AnimatedSpriteDesc desc{};
-    desc.material = g_theRenderer->GetMaterial("explosion");
+    desc.material = GetMaterial();
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
         desc.spriteSheet = game->explosion_sheet;
     }
@@ -32,11 +57,11 @@ Explosion::Explosion(std::weak_ptr<Scene> scene, Vector2 position)
     desc.playbackMode = AnimatedSprite::SpriteAnimMode::Play_To_End;
     desc.frameLength = 25;
     desc.startSpriteIndex = 0;
-    _sprite = g_theRenderer->CreateAnimatedSprite(desc);
+    _sprite = rs->CreateAnimatedSprite(desc);
 
     SetPosition(position);
-    const auto half_frameWidth = static_cast<float>(_sprite->GetFrameDimensions().x) * 0.5f;
-    const auto half_frameHeight = static_cast<float>(_sprite->GetFrameDimensions().y) * 0.5f;
+    const auto half_frameWidth = _sprite ? static_cast<float>(_sprite->GetFrameDimensions().x) * 0.5f : 0.0f;
+    const auto half_frameHeight = _sprite ? static_cast<float>(_sprite->GetFrameDimensions().y) * 0.5f : 0.0f;
     SetCosmeticRadius((std::max)(half_frameWidth, half_frameHeight));
     SetPhysicalRadius(GetCosmeticRadius() * 0.8f);
 
@@ -44,43 +69,28 @@ Explosion::Explosion(std::weak_ptr<Scene> scene, Vector2 position)
 
 void Explosion::Update(TimeUtils::FPSeconds deltaSeconds) noexcept {
     GameEntity::Update(deltaSeconds);
+    if(!_sprite) {
+        return;
+    }
+    RefreshSpriteMaterial(*_sprite);
     _sprite->Update(deltaSeconds);
 
-    const auto uvs = _sprite->GetCurrentTexCoords();
     const auto frameWidth = static_cast<float>(_sprite->GetFrameDimensions().x);
     const auto frameHeight = static_cast<float>(_sprite->GetFrameDimensions().y);
     const auto half_extents = Vector2{frameWidth, frameHeight};
-    {
-        const auto S = Matrix4::CreateScaleMatrix(half_extents);
-        const auto R = Matrix4::Create2DRotationDegreesMatrix(GetOrientationDegrees());
-        const auto T = Matrix4::CreateTranslationMatrix(GetPosition());
-        UpdateComponent<TransformComponent>(Matrix4::MakeSRT(S, R, T));
-    }
-
-    auto& builder = m_mesh_builder;
-    builder.Begin(PrimitiveType::Triangles);
-    builder.SetColor(Rgba::White);
-
-    builder.SetUV(Vector2{uvs.maxs.x, uvs.maxs.y});
-    builder.AddVertex(Vector2{+0.5f, +0.5f});
-
-    builder.SetUV(Vector2{uvs.mins.x, uvs.maxs.y});
-    builder.AddVertex(Vector2{-0.5f, +0.5f});
-
-    builder.SetUV(Vector2{uvs.mins.x, uvs.mins.y});
-    builder.AddVertex(Vector2{-0.5f, -0.5f});
-
-    builder.SetUV(Vector2{uvs.maxs.x, uvs.mins.y});
-    builder.AddVertex(Vector2{+0.5f, -0.5f});
-
-    builder.AddIndicies(Mesh::Builder::Primitive::Quad);
-    builder.End(GetMaterial());
+    UpdateTransform(half_extents);
+}
 
+bool Explosion::AppendToSpriteBatch(SpriteBatch& batch) const noexcept {
+    const auto uvs = _sprite ? _sprite->GetCurrentTexCoords() : AABB2::Zero_to_One;
+    batch.Add(m_material, MakeSpriteInstance(uvs));
+    return true;
 }
 
 void Explosion::EndFrame() noexcept {
     GameEntity::EndFrame();
-    if(_sprite->IsFinished()) {
+    //Without a sprite there is no animation to wait on.
+    if(!_sprite || _sprite->IsFinished()) {
         Kill();
     }
 }
@@ -89,10 +99,6 @@ void Explosion::OnDestroy() noexcept {
     GameEntity::OnDestroy();
 }
 
-Material* Explosion::GetMaterial() const noexcept {
-    return g_theRenderer->GetMaterial("explosion");
-}
-
 void Explosion::OnFire() noexcept {
     /* DO NOTHING */
 }
@@ -102,7 +108,7 @@ void Explosion::OnCollision(GameEntity* /*a*/, GameEntity* /*b*/) noexcept {
 }
 
 void Explosion::OnCreate() noexcept {
-    AudioSystem::SoundDesc desc{};
-    desc.groupName = g_audiogroup_sound;
-    g_theAudioSystem->Play(g_sound_explosionpath, desc);
+    if(auto* game = GetGameAs<Game>(); game != nullptr) {
+        game->GetAudio().Play(game->sounds.explosion);
+    }
 }
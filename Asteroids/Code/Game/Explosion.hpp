@@ -8,6 +8,7 @@
 
 #include "Game/GameEntity.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <utility>
 
@@ -18,7 +19,11 @@ public:
     explicit Explosion(std::weak_ptr<Scene> scene, Vector2 position);
 
     virtual ~Explosion() = default;
+
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size) noexcept;
     void Update(TimeUtils::FPSeconds deltaSeconds) noexcept override;
+    bool AppendToSpriteBatch(SpriteBatch& batch) const noexcept override;
     void EndFrame() noexcept override;
 
     void OnCreate() noexcept override;
@@ -26,7 +31,6 @@ public:
     void OnCollision(GameEntity* a, GameEntity* b) noexcept override;
     void OnDestroy() noexcept override;
 
-    Material* GetMaterial() const noexcept override;
 private:
     std::unique_ptr<AnimatedSprite> _sprite{};
 };
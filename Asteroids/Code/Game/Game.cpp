@@ -12,6 +12,10 @@
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/Material.hpp"
 
+#include "Engine/Services/ServiceLocator.hpp"
+#include "Engine/Services/IAudioService.hpp"
+#include "Engine/Services/IRendererService.hpp"
+
 #include "Engine/UI/UISystem.hpp"
 
 #include "Game/GameCommon.hpp"
@@ -25,11 +29,19 @@
 #include "Game/Mine.hpp"
 
 #include "Game/GameState.hpp"
+#include "Game/AllocationCounter.hpp"
+#include "Game/BenchmarkRunner.hpp"
+#include "Game/HeadlessRunner.hpp"
 #include "Game/MainState.hpp"
 #include "Game/TitleState.hpp"
+#include "Game/UnitQuad.hpp"
 
 #include <algorithm>
+#include <charconv>
+#include <chrono>
 #include <cmath>
+#include <format>
+#include <random>
 
 void GameOptions::SaveToConfig(Config& config) noexcept {
     GameSettings::SaveToConfig(config);
@@ -116,12 +128,81 @@ float GameOptions::GetMaxShakeAngle() const noexcept {
 }
 
 void Game::Initialize() noexcept {
+    _startup_begin = std::chrono::steady_clock::now();
     _current_state = std::move(std::make_unique<TitleState>());
     CreateOrLoadOptionsFile();
-    g_theRenderer->RegisterMaterialsFromFolder(g_material_folderpath);
+    if(IsHeadless()) {
+        ProvideNullServices();
+        RegisterMaterials();
+        RegisterSounds();
+        StartAudio();
+        if(IsBenchmark()) {
+            RunBenchmark();
+        } else {
+            RunHeadless();
+        }
+        return;
+    }
     g_theRenderer->SetWindowTitle(g_title_str);
-    InitializeAudio();
-    particleSystem->RegisterEffectsFromFolder(FileUtils::GetKnownFolderPath(FileUtils::KnownPathID::GameData) / "ParticleEffects");
+    RegisterMaterials();
+    //Before any state runs, so early plays (e.g. the options preview) queue instead of being dropped.
+    RegisterSounds();
+    StartAssetLoading();
+}
+
+void Game::StartAssetLoading() noexcept {
+    //Created here so the background thread never races the lazy creation.
+    auto& jobs = GetJobSystem();
+    const auto particle_folderpath = FileUtils::GetKnownFolderPath(FileUtils::KnownPathID::GameData) / "ParticleEffects";
+    auto background = [this, &jobs, particle_folderpath]() {
+        (void)AssetLoader::Prefetch(jobs, {g_material_folderpath, g_sound_folderpath, g_music_folderpath, particle_folderpath});
+        (void)PackSpriteAtlas(&jobs);
+    };
+    //The atlas image has to be on disk before the material that samples it is loaded.
+    std::vector<AssetLoader::Step> steps{};
+    steps.push_back({"atlas", [this]() { sprite_atlas.Bind(GameEntity::GetMaterialRegistry(), g_atlas_material_name); }});
+    AssetLoader::AppendFolderSteps(steps, "materials", g_material_folderpath, ".material", [](const std::filesystem::path& path) { g_theRenderer->RegisterMaterial(path); });
+    steps.push_back({"materials", []() { GameEntity::GetMaterialRegistry().Refresh(); }});
+    AssetLoader::AppendFolderSteps(steps, "sounds", g_sound_folderpath, ".wav", [](const std::filesystem::path& path) { g_theAudioSystem->RegisterWavFile(path); });
+    steps.push_back({"sounds", [this]() { StartAudio(); }});
+    AssetLoader::AppendFolderSteps(steps, "music", g_music_folderpath, ".wav", [](const std::filesystem::path& path) { g_theAudioSystem->RegisterWavFile(path); });
+    AssetLoader::AppendFolderSteps(steps, "particles", particle_folderpath, ".effect", [this](const std::filesystem::path& path) { particleSystem->RegisterEffectFromFile(path); });
+    _assets.Start(std::move(background), std::move(steps));
+}
+
+bool Game::AreAssetsReady() const noexcept {
+    return _assets.IsReady();
+}
+
+void Game::ReportStartup() noexcept {
+    const auto since_start = [this]() {
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - _startup_begin).count();
+    };
+    auto report = std::format("startup: assets ready after {:.1f}ms (background {:.1f}ms", since_start(), _assets.GetBackgroundTime().count() * 1000.0f);
+    //Per-file steps share a name and are summed; they are adjacent, so a change of name starts the next total.
+    const auto& steps = _assets.GetSteps();
+    for(std::size_t i = 0u; i < steps.size();) {
+        auto elapsed = TimeUtils::FPSeconds{};
+        auto count = std::size_t{0u};
+        const auto& name = steps[i].name;
+        for(; i < steps.size() && steps[i].name == name; ++i, ++count) {
+            elapsed += steps[i].elapsed;
+        }
+        report += std::format(", {} {:.1f}ms in {} steps", name, elapsed.count() * 1000.0f, count);
+    }
+    report += ")\n";
+    for(const auto& step : steps) {
+        if(step.overBudget) {
+            report += std::format("startup: {} step {} took {:.1f}ms, over the {:.1f}ms frame budget\n", step.name, step.file.empty() ? std::string{"-"} : step.file, step.elapsed.count() * 1000.0f, AssetLoader::default_frame_budget.count() * 1000.0f);
+        }
+    }
+    WriteStartupLog(report);
+}
+
+void Game::WriteStartupLog(std::string_view text) noexcept {
+    _startup_log += text;
+    (void)FileUtils::CreateFolders("Data/Logs/");
+    (void)FileUtils::WriteBufferToFile(_startup_log, "Data/Logs/startup.txt");
 }
 
 void Game::InitializeAudio() noexcept {
@@ -129,10 +210,41 @@ void Game::InitializeAudio() noexcept {
     InitializeMusic();
 }
 
+void Game::RegisterMaterials() noexcept {
+    //Resolved again by Refresh once the material files are loaded.
+    auto& registry = GameEntity::GetMaterialRegistry();
+    materials.asteroid = registry.Register("asteroid");
+    materials.bullet = registry.Register("bullet");
+    materials.explosion = registry.Register("explosion");
+    materials.mine = registry.Register("mine");
+    materials.ship = registry.Register("ship");
+    materials.thrust = registry.Register("thrust");
+    materials.ufo = registry.Register("ufo");
+    materials.flat2D = registry.Register("__2D");
+    (void)registry.Register(g_atlas_material_name);
+    registry.Lock();
+}
+
 void Game::InitializeSounds() noexcept {
     g_theAudioSystem->RegisterWavFilesFromFolder(g_sound_folderpath);
 }
 
+void Game::RegisterSounds() noexcept {
+    //Headless runs have no audio system, so the stand-in backend keeps the command path measurable.
+    _audio.SetBackend(IsHeadless() ? static_cast<IAudioBackend*>(&_recording_audio) : static_cast<IAudioBackend*>(&_device_audio));
+    sounds.shoot = _audio.Register(g_sound_shootpath);
+    sounds.hit = _audio.Register(g_sound_hitpath);
+    sounds.explosion = _audio.Register(g_sound_explosionpath);
+    sounds.warble = _audio.Register(g_sound_warblepath, true);
+}
+
+void Game::StartAudio() noexcept {
+    //The engine AudioSystem is also updated, suspended, resumed and fed wav files from the main thread
+    //and is not thread-safe, so the device backend is drained there by Flush in EndFrame.
+    //Only the recording backend, which touches nothing but its own counters, gets the audio thread.
+    _audio.Start(_audio_thread && IsHeadless());
+}
+
 void Game::InitializeMusic() noexcept {
     g_theAudioSystem->RegisterWavFilesFromFolder(g_music_folderpath);
     //TODO: Fix music
@@ -143,6 +255,110 @@ void Game::InitializeMusic() noexcept {
     //g_theAudioSystem->Play(g_music_bgmpath, desc);
 }
 
+void Game::BuildSpriteAtlas() noexcept {
+    (void)PackSpriteAtlas(nullptr);
+    sprite_atlas.Bind(GameEntity::GetMaterialRegistry(), g_atlas_material_name);
+}
+
+bool Game::PackSpriteAtlas(JobSystem* jobs) noexcept {
+    //Only batched sprites whose own shader is entity.hlsl, like the atlas material's.
+    //The UFO shader reads the style index, and the ship and thrust are not batched.
+    static const std::vector<SpriteAtlas::Source> sources{
+        {"asteroid", "Data/Images/asteroid.png"}
+        , {"mine", "Data/Images/mine.png"}
+        , {"explosion", "Data/Images/explosion.png"}
+        , {"bullet", "Data/Images/laserBullet.png"}
+    };
+    return sprite_atlas.Build(sources, g_atlas_image_filepath, g_atlas_manifest_filepath, jobs);
+}
+
+void Game::ReloadMaterials() noexcept {
+    BuildSpriteAtlas();
+    g_theRenderer->RegisterMaterialsFromFolder(g_material_folderpath);
+    GameEntity::GetMaterialRegistry().Refresh();
+    UnitQuad::Clear();
+}
+
+void Game::ProvideNullServices() noexcept {
+    static NullRendererService null_renderer{};
+    static NullAudioService null_audio{};
+    ServiceLocator::provide(*static_cast<IRendererService*>(&null_renderer));
+    ServiceLocator::provide(*static_cast<IAudioService*>(&null_audio));
+}
+
+void Game::RunHeadless() noexcept {
+    HeadlessRunner::Options options{};
+    options.ticks = static_cast<std::size_t>((std::max)(_headless_ticks, 0));
+    options.tickDuration = GetSimulationStep();
+    options.verifySnapshots = _verify_snapshots;
+    options.verifyDraws = _verify_draws;
+    options.recordInputPath = _record_input;
+    options.replayInputPath = _replay_input;
+    options.verifyReplay = _verify_replay;
+    HeadlessRunner runner{options};
+    const auto result = runner.Run(*this);
+    if(!result.inputLoaded) {
+        (void)FileUtils::CreateFolders("Data/Logs/");
+        (void)FileUtils::WriteBufferToFile(std::format("headless: could not read input log {}\n", _replay_input), "Data/Logs/headless.txt");
+        g_theApp<Game>->SetIsQuitting(true);
+        return;
+    }
+
+    auto report = std::format("headless: seed {}, {} ticks in {:.3f}s, {:.1f} ticks/s, {} restarts\n", _run_seed, result.ticks, result.elapsed.count(), result.ticksPerSecond, result.restarts);
+    if(options.verifySnapshots) {
+        report += std::format("snapshots: {} verified, {} inconsistent\n", result.snapshotsVerified, result.snapshotsInconsistent);
+    }
+    if(options.verifyDraws) {
+        report += std::format("draws: {} ticks verified, {} mismatched, peak {} draws for {} sprites\n", result.drawsVerified, result.drawsMismatched, result.peakDrawsPerTick, result.peakSpritesPerTick);
+    }
+    report += std::format("lead shots: {} verified, {} mismatched\n", result.leadShotsVerified, result.leadShotsMismatched);
+    if(result.inputReplayed) {
+        report += std::format("input: replayed {} frames from {}\n", result.ticks, _replay_input);
+    }
+    if(!options.recordInputPath.empty()) {
+        report += std::format("input: {} {}\n", result.inputSaved ? "saved to" : "could not save", _record_input);
+    }
+    report += std::format("state hash: {:016x}\n", result.finalStateHash);
+    if(options.verifyReplay) {
+        report += std::format("replay: {:016x} {:016x} {}\n", result.replayHashes[0], result.replayHashes[1], result.replaysMatch ? "match" : "MISMATCH");
+    }
+    if constexpr(AllocationCounter::is_enabled) {
+        report += std::format("allocations: {} ({} bytes), peak {} in one tick, {} of {} ticks allocation-free, last allocating tick {}\n", result.allocations, result.allocatedBytes, result.peakTickAllocations, result.ticksWithoutAllocations, result.ticks, result.lastAllocatingTick);
+        report += std::format("steady state: {} of {} ticks past warm-up allocated, {}\n", result.steadyAllocatingTicks, result.steadyTicks, result.steadyAllocatingTicks == 0u ? "ok" : "FAILED");
+    } else {
+        report += "allocations: not counted, this build does not define ASTEROIDS_COUNT_ALLOCATIONS\n";
+    }
+    //Stopped first so every queued command is counted.
+    _audio.Shutdown();
+    const auto audio = _audio.GetStats();
+    const auto backend = _recording_audio.GetStats();
+    report += std::format("audio: {} queued, {} dropped, peak depth {}/{}, {} played, {} stopped, latency mean {:.3f}ms max {:.3f}ms\n", audio.queue.pushed, audio.queue.dropped, audio.queue.peakDepth, audio.queue.capacity, backend.plays, backend.stops, audio.meanLatency.count(), audio.maxLatency.count());
+    (void)FileUtils::CreateFolders("Data/Logs/");
+    (void)FileUtils::WriteBufferToFile(report, "Data/Logs/headless.txt");
+    g_theApp<Game>->SetIsQuitting(true);
+}
+
+void Game::RunBenchmark() noexcept {
+    BenchmarkRunner::Options options{};
+    options.frames = static_cast<std::size_t>((std::max)(_benchmark_frames, 1));
+    options.frameDuration = GetSimulationStep();
+    options.scenario = _benchmark;
+    BenchmarkRunner runner{options};
+    const auto results = runner.Run(*this);
+    const auto integrate = runner.RunIntegrate(_run_seed);
+
+    (void)FileUtils::CreateFolders("Data/Logs/");
+    (void)FileUtils::WriteBufferToFile(BenchmarkRunner::ToJson(results, integrate, _run_seed), "Data/Logs/benchmark.json");
+    (void)FileUtils::WriteBufferToFile(BenchmarkRunner::ToCsv(results, integrate), "Data/Logs/benchmark.csv");
+    auto summary = std::format("benchmark: {} scenario(s), seed {}, results in Data/Logs/benchmark.json\n", results.size(), _run_seed);
+    for(const auto& result : integrate) {
+        const auto passed = result.withinTolerance && result.pendingUntouched;
+        summary += std::format("integrate: {} slots, batched {:.4f}ms, per entity {:.4f}ms median, max relative error {:.3e}, {}\n", result.slots, result.batched.median_ms, result.perEntity.median_ms, result.maxRelativeError, passed ? "ok" : "FAILED");
+    }
+    (void)FileUtils::WriteBufferToFile(summary, "Data/Logs/benchmark.txt");
+    g_theApp<Game>->SetIsQuitting(true);
+}
+
 void Game::BeginFrame() noexcept {
     if(_next_state) {
         _current_state->OnExit();
@@ -173,33 +389,74 @@ bool Game::IsPaused() const noexcept {
     return _paused;
 }
 
+bool Game::IsHeadless() const noexcept {
+    //The benchmark steps frames outside the engine's frame loop, where nothing can be presented.
+    return _headless || IsBenchmark();
+}
+
+bool Game::IsBenchmark() const noexcept {
+    return !_benchmark.empty();
+}
+
+bool Game::IsRenderThreaded() const noexcept {
+    return _render_thread;
+}
+
+JobSystem& Game::GetJobSystem() noexcept {
+    if(!_jobs) {
+        const auto worker_count = _worker_threads < 0 ? JobSystem::GetDefaultWorkerCount() : static_cast<std::size_t>(_worker_threads);
+        _jobs = std::make_unique<JobSystem>(worker_count);
+    }
+    return *_jobs;
+}
+
+AudioDispatcher& Game::GetAudio() noexcept {
+    return _audio;
+}
+
+SpawnQueue& Game::GetSpawnQueue() noexcept {
+    return _spawns;
+}
+
+uint64_t Game::GetRunSeed() const noexcept {
+    return _run_seed;
+}
+
+void Game::SetRunSeed(uint64_t seed) noexcept {
+    _run_seed = seed;
+}
+
+TimeUtils::FPSeconds Game::GetSimulationStep() const noexcept {
+    return TimeUtils::FPSeconds{1.0f / static_cast<float>(_sim_hz)};
+}
+
 void Game::SetAsteroidSpriteSheet() noexcept {
     if(!asteroid_sheet) {
-        asteroid_sheet = g_theRenderer->CreateSpriteSheet("Data/Images/asteroid.png", 6, 5);
+        asteroid_sheet = ServiceLocator::get<IRendererService>()->CreateSpriteSheet("Data/Images/asteroid.png", 6, 5);
     }
 }
 
 void Game::SetMineSpriteSheet() noexcept {
     if(!mine_sheet) {
-        mine_sheet = g_theRenderer->CreateSpriteSheet("Data/Images/mine.png", 3, 4);
+        mine_sheet = ServiceLocator::get<IRendererService>()->CreateSpriteSheet("Data/Images/mine.png", 3, 4);
     }
 }
 
 void Game::SetExplosionSpriteSheet() noexcept {
     if(!explosion_sheet) {
-        explosion_sheet = g_theRenderer->CreateSpriteSheet("Data/Images/explosion.png", 5, 5);
+        explosion_sheet = ServiceLocator::get<IRendererService>()->CreateSpriteSheet("Data/Images/explosion.png", 5, 5);
     }
 }
 
 void Game::SetUfoSpriteSheets() noexcept {
     if(!ufo_sheet) {
-        ufo_sheet = g_theRenderer->CreateSpriteSheet("Data/Images/ufo.png", 1, 4);
+        ufo_sheet = ServiceLocator::get<IRendererService>()->CreateSpriteSheet("Data/Images/ufo.png", 1, 4);
     }
 }
 
 void Game::SetLaserChargeSpriteSheet() noexcept {
     if(!lasercharge_sheet) {
-        lasercharge_sheet = g_theRenderer->CreateSpriteSheet("Data/Images/laser_chargeup.png", 4, 4);
+        lasercharge_sheet = ServiceLocator::get<IRendererService>()->CreateSpriteSheet("Data/Images/laser_chargeup.png", 4, 4);
     }
 }
 
@@ -298,10 +555,35 @@ void Game::CreateOrLoadOptionsFile() noexcept {
     g_theConfig->GetValue("music", musicV);
     gameOptions.SetMusicVolume(musicV);
 
+    g_theConfig->GetValue("headless", _headless);
+    g_theConfig->GetValue("headlessTicks", _headless_ticks);
+    g_theConfig->GetValue("simHz", _sim_hz);
+    g_theConfig->GetValue("benchmark", _benchmark);
+    g_theConfig->GetValue("benchmarkFrames", _benchmark_frames);
+    g_theConfig->GetValue("renderThread", _render_thread);
+    g_theConfig->GetValue("audioThread", _audio_thread);
+    g_theConfig->GetValue("workerThreads", _worker_threads);
+    g_theConfig->GetValue("verifySnapshots", _verify_snapshots);
+    g_theConfig->GetValue("verifyDraws", _verify_draws);
+    g_theConfig->GetValue("recordInput", _record_input);
+    g_theConfig->GetValue("replayInput", _replay_input);
+    g_theConfig->GetValue("verifyReplay", _verify_replay);
+    _sim_hz = std::clamp(_sim_hz, 10, 240);
+
+    //A fixed seed replays a run exactly; without one, pick a fresh seed and report it.
+    std::string seed{};
+    g_theConfig->GetValue("seed", seed);
+    if(const auto* const last = seed.data() + seed.size(); seed.empty() || std::from_chars(seed.data(), last, _run_seed).ptr != last) {
+        _run_seed = (static_cast<uint64_t>(std::random_device{}()) << 32u) | std::random_device{}();
+    }
+
 }
 
 void Game::Update(TimeUtils::FPSeconds deltaSeconds) noexcept {
     g_theRenderer->UpdateGameTime(deltaSeconds);
+    if(_assets.Pump(AssetLoader::default_frame_budget)) {
+        ReportStartup();
+    }
     _current_state->Update(deltaSeconds);
     auto* app = ServiceLocator::get<IAppService>();
     if(IsPaused() || app->LostFocus()) {
@@ -317,6 +599,11 @@ void Game::Render() const noexcept {
 
 void Game::EndFrame() noexcept {
     _current_state->EndFrame();
+    _audio.Flush();
+    if(!_first_frame_reported && !IsHeadless()) {
+        _first_frame_reported = true;
+        WriteStartupLog(std::format("startup: first frame after {:.1f}ms\n", std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - _startup_begin).count()));
+    }
 }
 
 void Game::DoCameraShake(OrthographicCameraController& controller) const noexcept {
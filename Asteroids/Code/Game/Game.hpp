@@ -25,13 +25,24 @@
 
 #include "Game/GameCommon.hpp"
 
+#include "Game/AssetLoader.hpp"
+#include "Game/AudioDispatcher.hpp"
+#include "Game/DeviceAudioBackend.hpp"
+#include "Game/RecordingAudioBackend.hpp"
+#include "Game/SpawnQueue.hpp"
 #include "Game/GameState.hpp"
 #include "Game/GameEntity.hpp"
+#include "Game/JobSystem.hpp"
+#include "Game/SimStopwatch.hpp"
 #include "Game/Player.hpp"
+#include "Game/SpriteAtlas.hpp"
 #include "Game/Ufo.hpp"
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 class Asteroid;
@@ -125,6 +136,26 @@ private:
     float _maxShakeAngle{10.0f};
 };
 
+//Every material the entities and HUD draw with, registered once at startup.
+struct GameMaterials {
+    MaterialHandle asteroid{};
+    MaterialHandle bullet{};
+    MaterialHandle explosion{};
+    MaterialHandle mine{};
+    MaterialHandle ship{};
+    MaterialHandle thrust{};
+    MaterialHandle ufo{};
+    MaterialHandle flat2D{};
+};
+
+//Every sound the entities play, registered once at startup.
+struct GameSounds {
+    SoundHandle shoot{};
+    SoundHandle hit{};
+    SoundHandle explosion{};
+    SoundHandle warble{};
+};
+
 class Game : public GameBase {
 public:
     Game() = default;
@@ -154,6 +185,21 @@ public:
     bool IsGameOver() const noexcept;
     void TogglePause() noexcept;
     bool IsPaused() const noexcept;
+    bool IsHeadless() const noexcept;
+    bool IsBenchmark() const noexcept;
+    bool IsRenderThreaded() const noexcept;
+    JobSystem& GetJobSystem() noexcept;
+    AudioDispatcher& GetAudio() noexcept;
+    //Entities ask for new entities through here; the current state commits them.
+    SpawnQueue& GetSpawnQueue() noexcept;
+    //False until the startup assets have finished loading in the background.
+    bool AreAssetsReady() const noexcept;
+    //Re-reads the material folder and re-resolves every registered material handle.
+    void ReloadMaterials() noexcept;
+    TimeUtils::FPSeconds GetSimulationStep() const noexcept;
+    uint64_t GetRunSeed() const noexcept;
+    //For replays, which have to run under the seed they were recorded with.
+    void SetRunSeed(uint64_t seed) noexcept;
 
     void SetAsteroidSpriteSheet() noexcept;
     void SetMineSpriteSheet() noexcept;
@@ -174,16 +220,31 @@ public:
     std::shared_ptr<SpriteSheet> mine_sheet{};
     std::shared_ptr<SpriteSheet> explosion_sheet{};
     std::shared_ptr<SpriteSheet> ufo_sheet{};
+    SpriteAtlas sprite_atlas{};
+    GameMaterials materials{};
+    GameSounds sounds{};
 
-    Stopwatch respawnTimer{TimeUtils::FPSeconds{1.0f}};
+    SimStopwatch respawnTimer{TimeUtils::FPSeconds{1.0f}};
     std::unique_ptr<ParticleSystem> particleSystem{};
 
     GameState* const GetCurrentState() const noexcept;
 protected:
 private:
+    void RegisterMaterials() noexcept;
     void InitializeAudio() noexcept;
     void InitializeSounds() noexcept;
     void InitializeMusic() noexcept;
+    void RegisterSounds() noexcept;
+    void StartAudio() noexcept;
+    void BuildSpriteAtlas() noexcept;
+    bool PackSpriteAtlas(JobSystem* jobs) noexcept;
+    void StartAssetLoading() noexcept;
+    void ReportStartup() noexcept;
+    //Appends to startup.txt under Data/Logs, rewritten in full each time.
+    void WriteStartupLog(std::string_view text) noexcept;
+    void ProvideNullServices() noexcept;
+    void RunHeadless() noexcept;
+    void RunBenchmark() noexcept;
 
     void CreateOrLoadOptionsFile() noexcept;
     void CreateOptionsFile() const noexcept;
@@ -196,5 +257,31 @@ private:
     bool _controller_control_active{false};
     bool _controlling_camera{false};
     bool _paused{false};
+    bool _headless{false};
+    int _headless_ticks{10000};
+    int _sim_hz{60};
+    std::string _benchmark{};
+    int _benchmark_frames{600};
+    bool _render_thread{true};
+    bool _audio_thread{true};
+    //Negative picks one per hardware thread, less the main thread.
+    int _worker_threads{-1};
+    std::unique_ptr<JobSystem> _jobs{};
+    SpawnQueue _spawns{};
+    DeviceAudioBackend _device_audio{};
+    RecordingAudioBackend _recording_audio{};
+    //Declared after the backends so its thread is stopped before they go away.
+    AudioDispatcher _audio{};
+    //Declared after _jobs so its background thread is joined before the workers go away.
+    AssetLoader _assets{};
+    std::chrono::steady_clock::time_point _startup_begin{};
+    bool _first_frame_reported{false};
+    std::string _startup_log{};
+    bool _verify_snapshots{false};
+    bool _verify_draws{false};
+    bool _verify_replay{false};
+    std::string _record_input{};
+    std::string _replay_input{};
+    uint64_t _run_seed{0u};
 };
 
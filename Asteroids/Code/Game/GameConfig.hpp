@@ -24,5 +24,8 @@ static std::string g_sound_warblepath{"Data/Audio/Sound/Warble.wav"};
 static std::string g_music_folderpath{"Data/Audio/Music/"};
 static std::string g_music_bgmpath{"Data/Audio/Music/bgm.wav"};
 static std::string g_material_folderpath{"Data/Materials/"};
+static std::string g_atlas_image_filepath{"Data/Cache/atlas.png"};
+static std::string g_atlas_manifest_filepath{"Data/Cache/atlas.manifest"};
+static std::string g_atlas_material_name{"atlas"};
 
 
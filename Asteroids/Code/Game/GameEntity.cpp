@@ -3,58 +3,97 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Math/MathUtils.hpp"
 
+#include "Engine/Renderer/AnimatedSprite.hpp"
+
 #include "Engine/Services/ServiceLocator.hpp"
 #include "Engine/Services/IRendererService.hpp"
 
 #include "Game/GameCommon.hpp"
 #include "Game/Game.hpp"
+#include "Game/RenderSnapshot.hpp"
 
 #include "Engine/Scene/Components.hpp"
 
+#include <algorithm>
+
 GameEntity::GameEntity(uint32_t handle, std::weak_ptr<Scene> scene, const GameEntity* parent /*= nullptr*/) noexcept
 : Entity(handle, scene)
 , m_gameParent(parent)
 {
     AddComponent<TransformComponent>(Matrix4::I);
     AddComponent<MeshComponent>(Mesh{});
+    m_kinematics_index = GetKinematicsStore().Acquire(this);
+    m_handle = GetHandleTable().Acquire(this);
+    m_spawn_id = s_next_spawn_id++;
+    m_sprite_material_epoch = GetMaterialRegistry().GetEpoch();
+    m_rng.Seed(s_run_seed, static_cast<uint64_t>(RandomStream::Subsystem::First_Entity) + m_spawn_id);
+}
+
+GameEntity::~GameEntity() noexcept {
+    GetHandleTable().Release(m_handle);
+    GetKinematicsStore().Release(m_kinematics_index);
+}
+
+KinematicsStore& GameEntity::GetKinematicsStore() noexcept {
+    static KinematicsStore store{};
+    return store;
+}
+
+KinematicsStore::index_type GameEntity::GetKinematicsIndex() const noexcept {
+    return m_kinematics_index;
+}
+
+MaterialRegistry& GameEntity::GetMaterialRegistry() noexcept {
+    static MaterialRegistry registry{};
+    return registry;
+}
+
+Material* GameEntity::GetMaterial() const noexcept {
+    return GetMaterialRegistry().GetMaterial(m_material);
+}
+
+Vector2 GameEntity::GetMaterialDimensions() const noexcept {
+    return GetMaterialRegistry().GetDiffuseDimensions(m_material);
+}
+
+EntityHandleTable& GameEntity::GetHandleTable() noexcept {
+    static EntityHandleTable table{};
+    return table;
+}
+
+EntityHandle GameEntity::GetHandle() const noexcept {
+    return m_handle;
 }
 
 void GameEntity::BeginFrame() noexcept {
-    m_mesh_builder.Clear();
-}
-
-void GameEntity::Update(TimeUtils::FPSeconds deltaSeconds) noexcept {
-    auto accel = CalcAcceleration();
-    auto vel = GetVelocity();
-    auto pos = GetPosition();
-    Vector2 new_accel = accel;
-    Vector2 new_vel = vel + new_accel * deltaSeconds.count();
-    Vector2 new_pos = pos + new_vel * deltaSeconds.count();
-    m_position_orientation_speed.x = new_pos.x;
-    m_position_orientation_speed.y = new_pos.y;
-    m_position_orientation_speed.w = new_vel.CalcLength();
-    auto new_direction = Vector2::X_Axis;
-    new_direction.SetUnitLengthAndHeadingDegrees(new_vel.CalcHeadingDegrees());
-    m_cosmeticphysicalradius_velocitydirection.z = new_direction.x;
-    m_cosmeticphysicalradius_velocitydirection.w = new_direction.y;
-    m_acceleration_force.x = new_accel.x;
-    m_acceleration_force.y = new_accel.y;
-
-    auto& transform = GetComponent<TransformComponent>();
-    const auto S = Matrix4::I;
-    const auto R = Matrix4::Create2DRotationMatrix(GetOrientationRadians());
-    const auto T = Matrix4::CreateTranslationMatrix(GetPosition());
-    transform.Transform = Matrix4::MakeSRT(S, R, T);
+    /* DO NOTHING */
+}
 
+void GameEntity::Update([[maybe_unused]] TimeUtils::FPSeconds deltaSeconds) noexcept {
+    //Integration happens for every entity at once in KinematicsStore::Integrate
+    //and each derived type writes its own scaled transform.
+}
+
+bool GameEntity::CanUpdateInParallel() const noexcept {
+    return true;
 }
 
 void GameEntity::Render() const noexcept {
-    ServiceLocator::get<IRendererService>()->SetModelMatrix(GetTransform());
-    Mesh::Render(m_mesh_builder);
+    /* DO NOTHING */
+}
+
+bool GameEntity::AppendToSpriteBatch([[maybe_unused]] SpriteBatch& batch) const noexcept {
+    return false;
+}
+
+void GameEntity::AppendToRenderSnapshot(RenderSnapshot& snapshot) const noexcept {
+    if(!AppendToSpriteBatch(snapshot.sprites)) {
+        snapshot.quads.push_back(RenderSnapshot::Quad{m_material, CalcRenderTransform()});
+    }
 }
 
 void GameEntity::EndFrame() noexcept {
-    ClearForce();
+    //Forces are cleared by MainState after every simulation tick.
 }
 
 Vector2 GameEntity::GetForward() const noexcept {
@@ -76,23 +115,23 @@ Vector2 GameEntity::GetLeft() const noexcept {
 }
 
 float GameEntity::GetCosmeticRadius() const noexcept {
-    return m_cosmeticphysicalradius_velocitydirection.x;
+    return GetKinematicsStore().cosmetic_radius[m_kinematics_index];
 }
 
 float GameEntity::GetPhysicalRadius() const noexcept {
-    return m_cosmeticphysicalradius_velocitydirection.y;
+    return GetKinematicsStore().physical_radius[m_kinematics_index];
 }
 
 float GameEntity::GetSpeed() const noexcept {
-    return m_position_orientation_speed.w;
+    return GetKinematicsStore().speed[m_kinematics_index];
 }
 
 void GameEntity::Kill() noexcept {
-    m_invmass_rotationspeed_health_padding.z = 0;
+    GetKinematicsStore().health[m_kinematics_index] = 0;
 }
 
 bool GameEntity::IsDead() const noexcept {
-    return m_invmass_rotationspeed_health_padding.z <= 0;
+    return GetKinematicsStore().health[m_kinematics_index] <= 0;
 }
 
 const Matrix4& GameEntity::GetTransform() const noexcept {
@@ -103,57 +142,123 @@ Matrix4& GameEntity::GetTransform() noexcept {
     return GetComponent<TransformComponent>();
 }
 
+void GameEntity::BeginRun(uint64_t runSeed) noexcept {
+    s_run_seed = runSeed;
+    s_next_spawn_id = 0u;
+}
+
+uint64_t GameEntity::GetRunSeed() noexcept {
+    return s_run_seed;
+}
+
+uint64_t GameEntity::GetSpawnId() const noexcept {
+    return m_spawn_id;
+}
+
+RandomStream& GameEntity::GetRandom() const noexcept {
+    return m_rng;
+}
+
+Matrix4 GameEntity::CalcRenderTransform() const noexcept {
+    const auto S = Matrix4::CreateScaleMatrix(m_render_scale);
+    const auto R = Matrix4::Create2DRotationDegreesMatrix(CalcRenderOrientationDegrees());
+    const auto T = Matrix4::CreateTranslationMatrix(CalcRenderPosition());
+    return Matrix4::MakeSRT(S, R, T);
+}
+
+Vector2 GameEntity::CalcRenderPosition() const noexcept {
+    return GetKinematicsStore().CalcInterpolatedPosition(m_kinematics_index, s_render_interpolation);
+}
+
+float GameEntity::CalcRenderOrientationDegrees() const noexcept {
+    return GetKinematicsStore().CalcInterpolatedOrientationDegrees(m_kinematics_index, s_render_interpolation);
+}
+
+void GameEntity::SetRenderInterpolation(float alpha) noexcept {
+    s_render_interpolation = std::clamp(alpha, 0.0f, 1.0f);
+}
+
+float GameEntity::GetRenderInterpolation() noexcept {
+    return s_render_interpolation;
+}
+
+SpriteInstance GameEntity::MakeSpriteInstance(const AABB2& uvs, const Vector4& state /*= Vector4::Zero*/) const noexcept {
+    SpriteInstance instance{};
+    instance.position = CalcRenderPosition();
+    instance.orientationDegrees = CalcRenderOrientationDegrees();
+    instance.scale = m_render_scale;
+    instance.uvs = uvs;
+    instance.state = state;
+    return instance;
+}
+
+void GameEntity::RefreshSpriteMaterial(AnimatedSprite& sprite) noexcept {
+    const auto epoch = GetMaterialRegistry().GetEpoch();
+    if(epoch != m_sprite_material_epoch) {
+        m_sprite_material_epoch = epoch;
+        sprite.SetMaterial(GetMaterial());
+    }
+}
+
+void GameEntity::UpdateTransform(Vector2 scale) noexcept {
+    m_render_scale = scale;
+    auto& store = GetKinematicsStore();
+    store.scale_x[m_kinematics_index] = scale.x;
+    store.scale_y[m_kinematics_index] = scale.y;
+    store.has_transform[m_kinematics_index] = 1u;
+}
+
+void GameEntity::ApplyTransform(const Matrix4& transform) noexcept {
+    UpdateComponent<TransformComponent>(transform);
+}
+
 void GameEntity::DecrementHealth() noexcept {
     if(!IsDead()) {
-        --m_invmass_rotationspeed_health_padding.z;
+        --GetKinematicsStore().health[m_kinematics_index];
     } else {
         Kill();
     }
 }
 
 void GameEntity::SetHealth(int newHealth) noexcept {
-    m_invmass_rotationspeed_health_padding.z = static_cast<float>(newHealth);
+    GetKinematicsStore().health[m_kinematics_index] = static_cast<float>(newHealth);
 }
 
 void GameEntity::SetPosition(Vector2 newPosition) noexcept {
-    m_position_orientation_speed.x = newPosition.x;
-    m_position_orientation_speed.y = newPosition.y;
+    GetKinematicsStore().SetPosition(m_kinematics_index, newPosition);
 }
 
 Vector2 GameEntity::GetPosition() const noexcept {
-    return m_position_orientation_speed.GetXY();
+    return GetKinematicsStore().GetPosition(m_kinematics_index);
 }
 
 void GameEntity::SetVelocity(Vector2 newVelocity) noexcept {
-    m_position_orientation_speed.w = newVelocity.Normalize();
-    m_cosmeticphysicalradius_velocitydirection.z = newVelocity.x;
-    m_cosmeticphysicalradius_velocitydirection.w = newVelocity.y;
+    auto& store = GetKinematicsStore();
+    store.speed[m_kinematics_index] = newVelocity.Normalize();
+    store.direction_x[m_kinematics_index] = newVelocity.x;
+    store.direction_y[m_kinematics_index] = newVelocity.y;
 }
 
 Vector2 GameEntity::GetVelocity() const noexcept {
-    return m_cosmeticphysicalradius_velocitydirection.GetZW() * m_position_orientation_speed.w;
+    const auto& store = GetKinematicsStore();
+    const auto i = m_kinematics_index;
+    return Vector2{store.direction_x[i], store.direction_y[i]} * store.speed[i];
 }
 
 Vector2 GameEntity::GetAcceleration() const noexcept {
-    return m_acceleration_force.GetXY();
-}
-
-Vector2 GameEntity::CalcAcceleration() noexcept {
-    return m_acceleration_force.GetZW() * GetInvMass();
+    const auto& store = GetKinematicsStore();
+    return Vector2{store.acceleration_x[m_kinematics_index], store.acceleration_y[m_kinematics_index]};
 }
 
 Vector2 GameEntity::GetForce() const noexcept {
-    return Vector2{m_acceleration_force.z, m_acceleration_force.w};
+    const auto& store = GetKinematicsStore();
+    return Vector2{store.force_x[m_kinematics_index], store.force_y[m_kinematics_index]};
 }
 
 void GameEntity::AddForce(const Vector2& force) noexcept {
-    m_acceleration_force.z += force.x;
-    m_acceleration_force.w += force.y;
-}
-
-void GameEntity::ClearForce() noexcept {
-    m_acceleration_force.z = 0.0f;
-    m_acceleration_force.w = 0.0f;
+    auto& store = GetKinematicsStore();
+    store.force_x[m_kinematics_index] += force.x;
+    store.force_y[m_kinematics_index] += force.y;
 }
 
 float GameEntity::GetMass() const noexcept {
@@ -161,11 +266,11 @@ float GameEntity::GetMass() const noexcept {
 }
 
 float GameEntity::GetInvMass() const noexcept {
-    return m_invmass_rotationspeed_health_padding.x;
+    return GetKinematicsStore().inverse_mass[m_kinematics_index];
 }
 
 void GameEntity::SetOrientationDegrees(float newDegrees) noexcept {
-    m_position_orientation_speed.z = newDegrees;
+    GetKinematicsStore().SetOrientationDegrees(m_kinematics_index, newDegrees);
 }
 
 void GameEntity::SetOrientationRadians(float newRadians) noexcept {
@@ -173,7 +278,7 @@ void GameEntity::SetOrientationRadians(float newRadians) noexcept {
 }
 
 float GameEntity::GetOrientationDegrees() const noexcept {
-    return m_position_orientation_speed.z;
+    return GetKinematicsStore().orientation_degrees[m_kinematics_index];
 }
 
 float GameEntity::GetOrientationRadians() const noexcept {
@@ -195,16 +300,17 @@ void GameEntity::RotateClockwise(float speed) noexcept {
 }
 
 void GameEntity::AdjustOrientation(float value) noexcept {
-    m_position_orientation_speed.z += value;
-    m_position_orientation_speed.z = MathUtils::Wrap(m_position_orientation_speed.z, 0.0f, 360.0f);
+    auto& orientation = GetKinematicsStore().orientation_degrees[m_kinematics_index];
+    orientation += value;
+    orientation = MathUtils::Wrap(orientation, 0.0f, 360.0f);
 }
 
 float GameEntity::GetRotationSpeed() const noexcept {
-    return m_invmass_rotationspeed_health_padding.y;
+    return GetKinematicsStore().rotation_speed[m_kinematics_index];
 }
 
 void GameEntity::SetRotationSpeed(float speed) noexcept {
-    m_invmass_rotationspeed_health_padding.y = speed;
+    GetKinematicsStore().rotation_speed[m_kinematics_index] = speed;
 }
 
 IWeapon* GameEntity::GetWeapon() const noexcept {
@@ -212,11 +318,11 @@ IWeapon* GameEntity::GetWeapon() const noexcept {
 }
 
 void GameEntity::SetCosmeticRadius(float value) noexcept {
-    m_cosmeticphysicalradius_velocitydirection.x = value;
+    GetKinematicsStore().cosmetic_radius[m_kinematics_index] = value;
 }
 
 void GameEntity::SetPhysicalRadius(float value) noexcept {
-    m_cosmeticphysicalradius_velocitydirection.y = value;
+    GetKinematicsStore().physical_radius[m_kinematics_index] = value;
 }
 
 bool GameEntity::HasGameParent() const noexcept {
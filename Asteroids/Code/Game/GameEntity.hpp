@@ -10,24 +10,56 @@
 #include "Engine/Scene/Entity.hpp"
 #include "Engine/Scene/Scene.hpp"
 
+#include "Game/EntityHandle.hpp"
+#include "Game/KinematicsStore.hpp"
+#include "Game/MaterialRegistry.hpp"
+#include "Game/RandomStream.hpp"
+#include "Game/SpriteBatch.hpp"
+
 #include <memory>
 
+class AnimatedSprite;
 class IWeapon;
+struct RenderSnapshot;
 
 class GameEntity : public a2de::Entity {
 public:
-    enum class Faction {
+    enum class Faction : uint8_t {
         None
         , Player
         , Enemy
         , Asteroid
+        , Max
+    };
+
+    enum class Kind : uint8_t {
+        None
+        , Ship
+        , Asteroid
+        , Bullet
+        , Ufo
+        , Mine
+        , Explosion
+        , Thrust
+        , Max
     };
 
     explicit GameEntity(uint32_t handle, std::weak_ptr<Scene> scene, const GameEntity* parent = nullptr) noexcept;
-    virtual ~GameEntity() = default;
+    GameEntity(const GameEntity& other) = delete;
+    GameEntity(GameEntity&& other) = delete;
+    GameEntity& operator=(const GameEntity& other) = delete;
+    GameEntity& operator=(GameEntity&& other) = delete;
+    virtual ~GameEntity() noexcept;
     virtual void BeginFrame() noexcept;
-    virtual void Update(TimeUtils::FPSeconds deltaSeconds) noexcept;
+    virtual void Update([[maybe_unused]] TimeUtils::FPSeconds deltaSeconds) noexcept;
+    //False for entities whose Update touches shared engine state and so has to stay on the main thread.
+    virtual bool CanUpdateInParallel() const noexcept;
+    //Draws live effects that are not captured in the render snapshot, e.g. engine particles.
     virtual void Render() const noexcept;
+    //Entities drawn through the sprite batch add themselves and return true.
+    virtual bool AppendToSpriteBatch(SpriteBatch& batch) const noexcept;
+    //Captures this frame's look by value; a batched sprite or, failing that, a unit quad.
+    virtual void AppendToRenderSnapshot(RenderSnapshot& snapshot) const noexcept;
     virtual void EndFrame() noexcept;
     virtual void OnCreate() noexcept = 0;
     virtual void OnCollision(GameEntity* a, GameEntity* b) noexcept = 0;
@@ -60,8 +92,17 @@ public:
 
     const Matrix4& GetTransform() const noexcept;
     Matrix4& GetTransform() noexcept;
+    //The transform blended between the last two simulation ticks.
+    Matrix4 CalcRenderTransform() const noexcept;
+    Vector2 CalcRenderPosition() const noexcept;
+    float CalcRenderOrientationDegrees() const noexcept;
+
+    static void SetRenderInterpolation(float alpha) noexcept;
+    static float GetRenderInterpolation() noexcept;
 
-    virtual Material* GetMaterial() const noexcept = 0;
+    virtual Material* GetMaterial() const noexcept;
+    //Size of the material's diffuse texture, resolved when the material was registered.
+    Vector2 GetMaterialDimensions() const noexcept;
 
     void DecrementHealth() noexcept;
 
@@ -70,15 +111,37 @@ public:
     Vector2 GetRight() const noexcept;
     Vector2 GetLeft() const noexcept;
 
+    static KinematicsStore& GetKinematicsStore() noexcept;
+    KinematicsStore::index_type GetKinematicsIndex() const noexcept;
+
+    static EntityHandleTable& GetHandleTable() noexcept;
+    static MaterialRegistry& GetMaterialRegistry() noexcept;
+    EntityHandle GetHandle() const noexcept;
+
+    //Starts a new run: entity random streams are re-keyed from the seed and spawn ids restart at zero.
+    static void BeginRun(uint64_t runSeed) noexcept;
+    static uint64_t GetRunSeed() noexcept;
+    uint64_t GetSpawnId() const noexcept;
+
     bool HasGameParent() const noexcept;
     const GameEntity* GetGameParent() const noexcept;
     GameEntity* GetGameParent() noexcept;
 
     long long scoreValue = 0ll;
     Faction faction = Faction::None;
+    Kind kind = Kind::None;
 protected:
     void SetHealth(int newHealth) noexcept;
 
+    //Records the scale; KinematicsStore::CalcTransforms builds the transform for every entity at once.
+    void UpdateTransform(Vector2 scale) noexcept;
+    SpriteInstance MakeSpriteInstance(const AABB2& uvs, const Vector4& state = Vector4::Zero) const noexcept;
+    //AnimatedSprite keeps the Material* it was created with, which a reload frees.
+    //Re-resolves it from m_material whenever the registry has been refreshed since.
+    void RefreshSpriteMaterial(AnimatedSprite& sprite) noexcept;
+
+    RandomStream& GetRandom() const noexcept;
+
     Vector2 GetForce() const noexcept;
     void AddForce(const Vector2& force) noexcept;
 
@@ -87,12 +150,9 @@ protected:
 
     IWeapon* m_weapon{};
     const GameEntity* m_gameParent{};
-    Mesh::Builder m_mesh_builder{};
+    MaterialHandle m_material{};
 private:
 
-    Vector2 CalcAcceleration() noexcept;
-    
-    void ClearForce() noexcept;
     float GetMass() const noexcept;
     float GetInvMass() const noexcept;
     
@@ -100,9 +160,16 @@ private:
     float GetOrientationRadians() const noexcept;
 
     void AdjustOrientation(float value) noexcept;
-
-    Vector4 m_position_orientation_speed{};
-    Vector4 m_cosmeticphysicalradius_velocitydirection{};
-    Vector4 m_acceleration_force{};
-    Vector4 m_invmass_rotationspeed_health_padding{1.0f, 90.0f, 1.0f, 0.0f};
+    void ApplyTransform(const Matrix4& transform) noexcept;
+
+    friend class KinematicsStore;
+    KinematicsStore::index_type m_kinematics_index{KinematicsStore::invalid_index};
+    EntityHandle m_handle{};
+    uint64_t m_spawn_id{0u};
+    mutable RandomStream m_rng{};
+    Vector2 m_render_scale{1.0f, 1.0f};
+    uint32_t m_sprite_material_epoch{0u};
+    static inline float s_render_interpolation{1.0f};
+    static inline uint64_t s_run_seed{0u};
+    static inline uint64_t s_next_spawn_id{0u};
 };
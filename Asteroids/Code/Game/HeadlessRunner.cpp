@@ -0,0 +1,276 @@
+#include "Game/HeadlessRunner.hpp"
+
+#include "Game/AllocationCounter.hpp"
+#include "Game/Bullet.hpp"
+#include "Game/Game.hpp"
+#include "Game/GameEntity.hpp"
+#include "Game/InputLog.hpp"
+#include "Game/MainState.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/SpriteBatch.hpp"
+#include "Game/UnitQuad.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <memory>
+
+namespace {
+
+//Everything a sprite's pose is interpolated from.
+[[nodiscard]] std::array<std::vector<float>*, 6> GetPoses(KinematicsStore& store) noexcept {
+    return {&store.position_x, &store.position_y, &store.orientation_degrees, &store.previous_position_x, &store.previous_position_y, &store.previous_orientation_degrees};
+}
+
+} // namespace
+
+HeadlessRunner::HeadlessRunner(const Options& options) noexcept
+: m_options(options)
+{
+    /* DO NOTHING */
+}
+
+HeadlessRunner::Result HeadlessRunner::Run(Game& game) noexcept {
+    Result result{};
+    InputLog loaded{};
+    InputLog* playback = nullptr;
+    if(!m_options.replayInputPath.empty()) {
+        if(!loaded.LoadFromFile(m_options.replayInputPath)) {
+            result.inputLoaded = false;
+            return result;
+        }
+        game.SetRunSeed(loaded.GetSeed());
+        playback = &loaded;
+        result.inputReplayed = true;
+    }
+    const auto ticks = playback ? playback->Size() : m_options.ticks;
+    //A replay would only record what it is already playing.
+    InputLog recorded{};
+    recorded.SetSeed(game.GetRunSeed());
+    recorded.Reserve(ticks);
+    auto* record = playback ? nullptr : &recorded;
+
+    const auto start = std::chrono::steady_clock::now();
+    result.finalStateHash = RunTicks(game, ticks, record, playback, result);
+    result.elapsed = std::chrono::duration_cast<TimeUtils::FPSeconds>(std::chrono::steady_clock::now() - start);
+    if(result.elapsed.count() > 0.0f) {
+        result.ticksPerSecond = static_cast<double>(result.ticks) / static_cast<double>(result.elapsed.count());
+    }
+    auto& input = playback ? *playback : recorded;
+    if(!m_options.recordInputPath.empty()) {
+        result.inputSaved = input.SaveToFile(m_options.recordInputPath);
+    }
+    if(m_options.verifyReplay) {
+        for(auto& hash : result.replayHashes) {
+            input.Rewind();
+            //Only the first run's statistics are reported.
+            Result replay{};
+            hash = RunTicks(game, input.Size(), nullptr, &input, replay);
+        }
+        result.replaysMatch = std::all_of(std::cbegin(result.replayHashes), std::cend(result.replayHashes), [&result](uint64_t hash) { return hash == result.finalStateHash; });
+    }
+    return result;
+}
+
+uint64_t HeadlessRunner::RunTicks(Game& game, std::size_t ticks, InputLog* record, InputLog* playback, Result& result) noexcept {
+    game.ChangeState(std::make_unique<MainState>());
+    ResetSnapshotChecks();
+    result.lastAllocatingTick = ticks;
+    MainState* state = nullptr;
+    auto ticks_in_state = std::size_t{0u};
+    for(; result.ticks < ticks; ++result.ticks) {
+        const auto allocations_before = AllocationCounter::GetTotals();
+        game.BeginFrame();
+        //Looked up every tick: a restart swaps the state out.
+        state = dynamic_cast<MainState*>(game.GetCurrentState());
+        if(state) {
+            state->SetInputRecording(record);
+            state->SetInputPlayback(playback);
+            if(m_options.verifySnapshots || m_options.verifyDraws) {
+                state->SetCaptureRenderSnapshots(true);
+            }
+        }
+        const auto newest_bullet = state ? CalcNewestBulletSpawnId(*state) : 0u;
+        game.GetCurrentState()->Update(m_options.tickDuration);
+        if(state) {
+            VerifyLeadShots(*state, newest_bullet, result);
+        }
+        if(state && m_options.verifySnapshots) {
+            VerifySnapshot(*state, result);
+        }
+        if(state && m_options.verifyDraws) {
+            if(const auto* snapshot = state->AcquireRenderSnapshot(); snapshot != nullptr) {
+                VerifyDraws(*state, *snapshot, result);
+            }
+        }
+        game.EndFrame();
+        const auto allocated = AllocationCounter::GetSince(allocations_before);
+        result.allocations += allocated.allocations;
+        result.allocatedBytes += allocated.bytes;
+        result.peakTickAllocations = (std::max)(result.peakTickAllocations, allocated.allocations);
+        if(allocated.allocations == 0u) {
+            ++result.ticksWithoutAllocations;
+        } else {
+            result.lastAllocatingTick = result.ticks;
+        }
+        if(m_options.warmUpTicks <= ticks_in_state) {
+            ++result.steadyTicks;
+            if(allocated.allocations != 0u) {
+                ++result.steadyAllocatingTicks;
+            }
+        }
+        ++ticks_in_state;
+        //Restart instead of fading out to the game over screen so long soaks keep simulating.
+        if(game.IsGameOver()) {
+            game.ChangeState(std::make_unique<MainState>());
+            ResetSnapshotChecks();
+            ++result.restarts;
+            ticks_in_state = 0u;
+        }
+    }
+    if(state == nullptr) {
+        return 0u;
+    }
+    const auto hash = state->CalcStateHash();
+    //The logs belong to the caller and may not outlive this run.
+    state->SetInputRecording(nullptr);
+    state->SetInputPlayback(nullptr);
+    return hash;
+}
+
+void HeadlessRunner::VerifySnapshot(const MainState& state, Result& result) noexcept {
+    auto& buffer = state.m_render_snapshots;
+    if(const auto next_frame = buffer.GetNextFrame(); next_frame > 0u) {
+        const auto frame = next_frame - 1u;
+        auto& expected = m_expected[frame % m_expected.size()];
+        if(!expected.valid || expected.frame != frame) {
+            m_reference.Clear();
+            state.CaptureRenderSnapshot(m_reference, state.m_world_bounds);
+            expected = ExpectedSnapshot{frame, m_reference.sprites.CalcAddedChecksum(), m_reference.sprites.GetInstanceCount(), true};
+            PoisonPoses();
+            buffer.WaitForPrepared();
+            RestorePoses();
+        }
+    }
+    const auto* snapshot = buffer.AcquireForDraw();
+    if(snapshot == nullptr) {
+        return;
+    }
+    ++result.snapshotsVerified;
+    const auto in_order = !m_has_verified_snapshot || snapshot->frame > m_last_snapshot_frame;
+    const auto& expected = m_expected[snapshot->frame % m_expected.size()];
+    const auto& sprites = snapshot->sprites;
+    const auto matches = expected.valid && expected.frame == snapshot->frame && sprites.GetInstances().size() == expected.sprites && sprites.CalcGroupedChecksum() == expected.checksum;
+    if(!in_order || !matches) {
+        ++result.snapshotsInconsistent;
+    }
+    m_last_snapshot_frame = snapshot->frame;
+    m_has_verified_snapshot = true;
+}
+
+void HeadlessRunner::ResetSnapshotChecks() noexcept {
+    m_has_verified_snapshot = false;
+    m_expected.fill(ExpectedSnapshot{});
+}
+
+void HeadlessRunner::PoisonPoses() noexcept {
+    const auto poses = GetPoses(GameEntity::GetKinematicsStore());
+    for(std::size_t i = 0u; i < poses.size(); ++i) {
+        m_saved_poses[i] = *poses[i];
+        std::fill(std::begin(*poses[i]), std::end(*poses[i]), std::numeric_limits<float>::quiet_NaN());
+    }
+}
+
+void HeadlessRunner::RestorePoses() noexcept {
+    const auto poses = GetPoses(GameEntity::GetKinematicsStore());
+    for(std::size_t i = 0u; i < poses.size(); ++i) {
+        *poses[i] = m_saved_poses[i];
+    }
+}
+
+void HeadlessRunner::VerifyDraws(const MainState& state, const RenderSnapshot& snapshot, Result& result) noexcept {
+    m_recorder.BeginFrame();
+    state.RenderEntities(snapshot, m_recorder);
+    ++result.drawsVerified;
+    if(!DrawsMatchBatch(snapshot, m_recorder.GetCommands())) {
+        ++result.drawsMismatched;
+    }
+    result.peakDrawsPerTick = (std::max)(result.peakDrawsPerTick, m_recorder.GetFrameStats().draws);
+    result.peakSpritesPerTick = (std::max)(result.peakSpritesPerTick, snapshot.sprites.GetInstanceCount());
+}
+
+uint64_t HeadlessRunner::CalcNewestBulletSpawnId(const MainState& state) noexcept {
+    auto newest = uint64_t{0u};
+    for(const auto* bullet : state.bullets) {
+        newest = (std::max)(newest, bullet->GetSpawnId());
+    }
+    return newest;
+}
+
+void HeadlessRunner::VerifyLeadShots(const MainState& state, uint64_t newestBefore, Result& result) noexcept {
+    if(state.ship == nullptr) {
+        return;
+    }
+    const auto input = state.ship->GetFrameInput();
+    if(!(input.buttons & PlayerInput::Button_FireAtVelocity)) {
+        return;
+    }
+    const auto expected = Vector2{input.fireVelocityX, input.fireVelocityY};
+    for(const auto* bullet : state.bullets) {
+        if(bullet->GetSpawnId() <= newestBefore || bullet->GetGameParent() != state.ship) {
+            continue;
+        }
+        ++result.leadShotsVerified;
+        const auto error = (bullet->GetVelocity() - expected).CalcLength() / (std::max)(1.0f, expected.CalcLength());
+        if(!(error <= leadShotTolerance)) {
+            ++result.leadShotsMismatched;
+        }
+    }
+}
+
+bool HeadlessRunner::DrawsMatchBatch(const RenderSnapshot& snapshot, const std::vector<RecordingRenderBackend::Command>& commands) noexcept {
+    using CommandType = RecordingRenderBackend::CommandType;
+    const auto& sprites = snapshot.sprites;
+    const auto& draws = sprites.GetDraws();
+    const auto quad_count = snapshot.quads.size();
+    auto draw_index = std::size_t{0u};
+    for(const auto& command : commands) {
+        if(command.type != CommandType::Draw) {
+            continue;
+        }
+        //Unbatched entities come first, one shared unit quad each.
+        if(draw_index < quad_count) {
+            const auto& quad = snapshot.quads[draw_index];
+            if(command.material != quad.material || command.vertices != UnitQuad::vertex_count || command.indices != UnitQuad::index_count) {
+                return false;
+            }
+        } else if(draw_index - quad_count < draws.size()) {
+            const auto& draw = draws[draw_index - quad_count];
+            if(command.material != draw.material || command.vertices != draw.instanceCount * SpriteBatch::vertices_per_sprite || command.indices != draw.instanceCount * SpriteBatch::indices_per_sprite) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+        ++draw_index;
+    }
+    if(draw_index != quad_count + draws.size()) {
+        return false;
+    }
+    std::size_t batched = 0u;
+    for(auto i = std::size_t{0u}; i < draws.size(); ++i) {
+        const auto& draw = draws[i];
+        if(draw.instanceCount == 0u || draw.firstInstance != batched) {
+            return false;
+        }
+        batched += draw.instanceCount;
+        const auto duplicate = std::any_of(std::cbegin(draws) + i + 1, std::cend(draws), [&draw](const SpriteBatch::Draw& other) {
+            return other.material == draw.material && other.hasState == draw.hasState && other.state == draw.state;
+        });
+        if(duplicate) {
+            return false;
+        }
+    }
+    //Every captured sprite made it into exactly one draw, unchanged.
+    return batched == sprites.GetInstances().size() && batched == sprites.GetInstanceCount() && sprites.CalcGroupedChecksum() == snapshot.capturedChecksum;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Engine/Core/TimeUtils.hpp"
+
+#include "Game/RecordingRenderBackend.hpp"
+#include "Game/RenderSnapshot.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+class Game;
+class InputLog;
+class MainState;
+
+//Steps MainState at a fixed tick as fast as possible with the renderer and
+//audio services swapped for their null implementations, for soak tests and
+//simulation throughput measurements on machines without a GPU or audio device.
+//Every run records the player's input per tick; the seed plus that log
+//reproduce the run, which verifyReplay checks by replaying it twice.
+class HeadlessRunner {
+public:
+    struct Options {
+        std::size_t ticks{10000u};
+        TimeUtils::FPSeconds tickDuration{1.0f / 60.0f};
+        //Capture a render snapshot every tick and check that the prepare thread
+        //saw exactly what the simulation captured, in order. The live entity
+        //poses are poisoned while it prepares, so reading them instead of the
+        //snapshot shows up as a mismatch.
+        bool verifySnapshots{false};
+        //Replay every tick's entity draws through a RecordingRenderBackend and
+        //check the draw calls and their instances against the sprite batch.
+        bool verifyDraws{false};
+        //Where to save the recorded input, if anywhere.
+        std::filesystem::path recordInputPath{};
+        //Replays this log, under the seed stored in it, instead of running the
+        //autopilot. The run lasts as many ticks as the log has frames.
+        std::filesystem::path replayInputPath{};
+        //Replays the run's input twice more and compares the final state hashes.
+        bool verifyReplay{false};
+        //Ticks after each (re)start that may allocate while pools, rings and
+        //scratch buffers grow to size; any later tick that allocates fails the run.
+        std::size_t warmUpTicks{600u};
+    };
+
+    struct Result {
+        std::size_t ticks{0u};
+        std::size_t restarts{0u};
+        TimeUtils::FPSeconds elapsed{};
+        double ticksPerSecond{0.0};
+        std::size_t snapshotsVerified{0u};
+        std::size_t snapshotsInconsistent{0u};
+        std::size_t drawsVerified{0u};
+        //Ticks whose recorded draws did not match the batch.
+        std::size_t drawsMismatched{0u};
+        std::size_t peakDrawsPerTick{0u};
+        std::size_t peakSpritesPerTick{0u};
+        //Ship bullets fired at a lead velocity, and those that did not spawn with it.
+        std::size_t leadShotsVerified{0u};
+        std::size_t leadShotsMismatched{0u};
+        //Counted by AllocationCounter from BeginFrame to EndFrame of each tick, on every thread.
+        uint64_t allocations{0u};
+        uint64_t allocatedBytes{0u};
+        uint64_t peakTickAllocations{0u};
+        std::size_t ticksWithoutAllocations{0u};
+        //The last tick that allocated anything, or ticks if none did.
+        std::size_t lastAllocatingTick{0u};
+        //Ticks past warmUpTicks, and those of them that allocated. Only meaningful
+        //when AllocationCounter::is_enabled.
+        std::size_t steadyTicks{0u};
+        std::size_t steadyAllocatingTicks{0u};
+        //MainState::CalcStateHash after the last tick.
+        uint64_t finalStateHash{0u};
+        bool inputReplayed{false};
+        //False if replayInputPath could not be read; nothing is run then.
+        bool inputLoaded{true};
+        bool inputSaved{false};
+        std::array<uint64_t, 2> replayHashes{};
+        bool replaysMatch{false};
+    };
+
+    //There is no output surface to size the world from.
+    static inline constexpr const float worldWidth{1600.0f};
+    static inline constexpr const float worldHeight{900.0f};
+    static inline constexpr const float leadShotTolerance{1e-4f};
+
+    explicit HeadlessRunner(const Options& options) noexcept;
+
+    [[nodiscard]] Result Run(Game& game) noexcept;
+
+protected:
+private:
+    //Runs a fresh MainState for ticks ticks and returns its final state hash.
+    [[nodiscard]] uint64_t RunTicks(Game& game, std::size_t ticks, InputLog* record, InputLog* playback, Result& result) noexcept;
+    //What a snapshot should hold, from a second capture of the live state taken right after the real one.
+    struct ExpectedSnapshot {
+        uint64_t frame{0u};
+        uint64_t checksum{0u};
+        std::size_t sprites{0u};
+        bool valid{false};
+    };
+
+    void VerifySnapshot(const MainState& state, Result& result) noexcept;
+    void ResetSnapshotChecks() noexcept;
+    void PoisonPoses() noexcept;
+    void RestorePoses() noexcept;
+    void VerifyDraws(const MainState& state, const RenderSnapshot& snapshot, Result& result) noexcept;
+    //Bullets are spawned from the queue after the tick that fires them, so the
+    //lead velocity has to survive the trip through the spawn request.
+    [[nodiscard]] static uint64_t CalcNewestBulletSpawnId(const MainState& state) noexcept;
+    static void VerifyLeadShots(const MainState& state, uint64_t newestBefore, Result& result) noexcept;
+    //Each sprite draw must match its batch group and no two groups may share a
+    //material and state; otherwise batching has fallen back to per-entity draws.
+    [[nodiscard]] static bool DrawsMatchBatch(const RenderSnapshot& snapshot, const std::vector<RecordingRenderBackend::Command>& commands) noexcept;
+
+    Options m_options{};
+    RecordingRenderBackend m_recorder{};
+    uint64_t m_last_snapshot_frame{0u};
+    bool m_has_verified_snapshot{false};
+    RenderSnapshot m_reference{};
+    //Threaded, the snapshot drawn is the one captured a tick earlier.
+    std::array<ExpectedSnapshot, 2> m_expected{};
+    std::array<std::vector<float>, 6> m_saved_poses{};
+};
@@ -0,0 +1,80 @@
+#include "Game/HudLayer.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/KerningFont.hpp"
+#include "Engine/Core/Rgba.hpp"
+
+#include "Engine/Renderer/Renderer.hpp"
+
+#include "Game/Game.hpp"
+#include "Game/GameCommon.hpp"
+#include "Game/GameEntity.hpp"
+
+#include <format>
+
+void HudLayer::Render(const Vector2& position, long long score, long long lives) noexcept {
+    if(IsStale(score, lives)) {
+        Layout(score, lives);
+    }
+    if(m_font == nullptr) {
+        return;
+    }
+    if(m_index_count > 0u) {
+        g_theRenderer->SetModelMatrix(Matrix4::CreateTranslationMatrix(position));
+        g_theRenderer->SetMaterial(m_font->GetMaterial());
+        g_theRenderer->DrawIndexed(PrimitiveType::Triangles, m_vertex_buffer.get(), m_index_buffer.get(), m_index_count);
+    }
+
+    const auto S = Matrix4::CreateScaleMatrix(m_icon_extents);
+    const auto R = Matrix4::I;
+    const auto T = Matrix4::CreateTranslationMatrix(position + m_icon_offset);
+    g_theRenderer->SetModelMatrix(Matrix4::MakeSRT(S, R, T));
+    g_theRenderer->SetMaterial(GameEntity::GetMaterialRegistry().GetMaterial(m_icon_material));
+    g_theRenderer->DrawQuad2D();
+}
+
+void HudLayer::Invalidate() noexcept {
+    m_dirty = true;
+}
+
+KerningFont* HudLayer::GetFont() const noexcept {
+    return m_font;
+}
+
+std::size_t HudLayer::GetLayoutCount() const noexcept {
+    return m_layout_count;
+}
+
+bool HudLayer::IsStale(long long score, long long lives) const noexcept {
+    //Reloading materials can free the font's material, so a refresh forces a layout as well.
+    return m_dirty || score != m_score || lives != m_lives || m_material_epoch != GameEntity::GetMaterialRegistry().GetEpoch();
+}
+
+void HudLayer::Layout(long long score, long long lives) noexcept {
+    auto& materials = GameEntity::GetMaterialRegistry();
+    m_font = g_theRenderer->GetFont("System32");
+    if(const auto* game = GetGameAs<Game>(); game != nullptr) {
+        m_icon_material = game->materials.ship;
+    }
+    m_score = score;
+    m_lives = lives;
+    m_material_epoch = materials.GetEpoch();
+    m_dirty = false;
+    ++m_layout_count;
+    m_vbo.clear();
+    m_ibo.clear();
+    m_vertex_buffer.reset();
+    m_index_buffer.reset();
+    m_index_count = 0u;
+    if(m_font == nullptr) {
+        return;
+    }
+    g_theRenderer->AppendMultiLineTextBuffer(m_font, std::format("Score: {}\n{:>6}{}", score, 'x', lives), Vector2::Zero, Rgba::White, m_vbo, m_ibo);
+    if(!m_vbo.empty() && !m_ibo.empty()) {
+        m_vertex_buffer = g_theRenderer->CreateVertexBuffer(m_vbo);
+        m_index_buffer = g_theRenderer->CreateIndexBuffer(m_ibo);
+        m_index_count = m_ibo.size();
+    }
+    m_icon_extents = materials.GetDiffuseDimensions(m_icon_material);
+    m_icon_offset = Vector2{15.0f + m_font->CalculateTextWidth(" "), m_font->GetLineHeight() * 1.8f};
+}
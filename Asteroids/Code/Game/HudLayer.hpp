@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Engine/Math/Matrix4.hpp"
+#include "Engine/Math/Vector2.hpp"
+
+#include "Engine/Renderer/IndexBuffer.hpp"
+#include "Engine/Renderer/Vertex3D.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+
+#include "Game/MaterialRegistry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class KerningFont;
+
+//Retained score and lives display. The glyph quads are laid out and uploaded
+//into renderer-owned vertex and index buffers only when the score or lives
+//change, or after materials are reloaded; every other frame just redraws
+//those buffers and the lives icon, with nothing sent to the GPU.
+class HudLayer {
+public:
+    HudLayer() noexcept = default;
+    HudLayer(const HudLayer& other) = delete;
+    HudLayer(HudLayer&& other) = delete;
+    HudLayer& operator=(const HudLayer& other) = delete;
+    HudLayer& operator=(HudLayer&& other) = delete;
+    ~HudLayer() noexcept = default;
+
+    //position is the top-left of the text in UI space.
+    void Render(const Vector2& position, long long score, long long lives) noexcept;
+    //Forces a layout on the next Render.
+    void Invalidate() noexcept;
+
+    //nullptr until the first Render.
+    [[nodiscard]] KerningFont* GetFont() const noexcept;
+    [[nodiscard]] std::size_t GetLayoutCount() const noexcept;
+
+protected:
+private:
+    [[nodiscard]] bool IsStale(long long score, long long lives) const noexcept;
+    void Layout(long long score, long long lives) noexcept;
+
+    KerningFont* m_font{nullptr};
+    MaterialHandle m_icon_material{};
+    //Icon scale and offset from the text position, in UI units.
+    Vector2 m_icon_extents{};
+    Vector2 m_icon_offset{};
+    //Staging for the layout; kept so later layouts reuse the allocation.
+    std::vector<Vertex3D> m_vbo{};
+    std::vector<unsigned int> m_ibo{};
+    std::unique_ptr<VertexBuffer> m_vertex_buffer{};
+    std::unique_ptr<IndexBuffer> m_index_buffer{};
+    std::size_t m_index_count{0u};
+    long long m_score{0ll};
+    long long m_lives{0ll};
+    uint32_t m_material_epoch{0u};
+    std::size_t m_layout_count{0u};
+    bool m_dirty{true};
+};
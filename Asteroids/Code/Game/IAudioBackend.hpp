@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Game/AudioCommandQueue.hpp"
+
+#include <filesystem>
+
+//Everything the audio dispatcher sends to the audio system. The game plays
+//through DeviceAudioBackend; headless runs swap in RecordingAudioBackend so
+//the command path can be measured without a device.
+class IAudioBackend {
+public:
+    virtual ~IAudioBackend() noexcept = default;
+
+    //Resolves path once, before any command names sound. Looping sounds play until stopped.
+    virtual void Load(SoundHandle sound, const std::filesystem::path& path, bool looping) noexcept = 0;
+    virtual void Play(SoundHandle sound, float volume) noexcept = 0;
+    //Stops every channel sound is playing on.
+    virtual void Stop(SoundHandle sound) noexcept = 0;
+
+protected:
+private:
+
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Engine/Math/Matrix4.hpp"
+
+#include "Engine/Renderer/Mesh.hpp"
+
+#include "Game/MaterialRegistry.hpp"
+
+#include <cstddef>
+
+//Everything the world render path sends to the renderer. MainState draws
+//through DeviceRenderBackend; benchmarks swap in RecordingRenderBackend so the
+//same path can be measured without a device.
+//Only the snapshot's unit quads and sprite batch go through here. The HUD text,
+//the debug overlay and the engine's particle effects still draw straight
+//through g_theRenderer, so recorded and benchmarked draw counts leave them out.
+class IRenderBackend {
+public:
+    virtual ~IRenderBackend() noexcept = default;
+
+    virtual void SetModelMatrix(const Matrix4& transform) noexcept = 0;
+    //Writes byteCount bytes of data to the first constant buffer of material's shader.
+    virtual void UpdateConstants(MaterialHandle material, const void* data, std::size_t byteCount) noexcept = 0;
+    //Binds material and draws mesh, which holds vertexCount vertices and indexCount indices.
+    virtual void DrawMesh(MaterialHandle material, const Mesh::Builder& mesh, std::size_t vertexCount, std::size_t indexCount) noexcept = 0;
+
+protected:
+private:
+
+};
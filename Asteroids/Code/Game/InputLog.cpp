@@ -0,0 +1,113 @@
+#include "Game/InputLog.hpp"
+
+#include <array>
+#include <fstream>
+#include <utility>
+
+namespace {
+
+constexpr const std::array<char, 4> file_magic{'I', 'L', 'O', 'G'};
+
+template<typename T>
+void WriteValue(std::ofstream& ofs, const T& value) noexcept {
+    ofs.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+[[nodiscard]] bool ReadValue(std::ifstream& ifs, T& value) noexcept {
+    return static_cast<bool>(ifs.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+} // namespace
+
+void InputLog::Clear() noexcept {
+    m_frames.clear();
+    m_cursor = 0u;
+}
+
+void InputLog::SetSeed(uint64_t seed) noexcept {
+    m_seed = seed;
+}
+
+uint64_t InputLog::GetSeed() const noexcept {
+    return m_seed;
+}
+
+void InputLog::Reserve(std::size_t frames) noexcept {
+    m_frames.reserve(frames);
+}
+
+void InputLog::Append(const PlayerInput& input) noexcept {
+    m_frames.push_back(input);
+}
+
+bool InputLog::Next(PlayerInput& input) noexcept {
+    if(m_cursor >= m_frames.size()) {
+        return false;
+    }
+    input = m_frames[m_cursor++];
+    return true;
+}
+
+void InputLog::Rewind() noexcept {
+    m_cursor = 0u;
+}
+
+std::size_t InputLog::Size() const noexcept {
+    return m_frames.size();
+}
+
+bool InputLog::IsEmpty() const noexcept {
+    return m_frames.empty();
+}
+
+bool InputLog::SaveToFile(const std::filesystem::path& path) const noexcept {
+    std::ofstream ofs{path, std::ios_base::binary | std::ios_base::trunc};
+    if(!ofs) {
+        return false;
+    }
+    //Field by field so the file does not depend on struct padding.
+    WriteValue(ofs, file_magic);
+    WriteValue(ofs, file_version);
+    WriteValue(ofs, m_seed);
+    WriteValue(ofs, static_cast<uint64_t>(m_frames.size()));
+    for(const auto& frame : m_frames) {
+        WriteValue(ofs, frame.orientationDegrees);
+        WriteValue(ofs, frame.fireOrientationDegrees);
+        WriteValue(ofs, frame.fireVelocityX);
+        WriteValue(ofs, frame.fireVelocityY);
+        WriteValue(ofs, frame.thrust);
+        WriteValue(ofs, frame.buttons);
+        WriteValue(ofs, static_cast<uint8_t>(frame.hasShip));
+    }
+    return static_cast<bool>(ofs);
+}
+
+bool InputLog::LoadFromFile(const std::filesystem::path& path) noexcept {
+    Clear();
+    std::ifstream ifs{path, std::ios_base::binary};
+    if(!ifs) {
+        return false;
+    }
+    auto magic = std::array<char, 4>{};
+    auto version = uint32_t{0u};
+    auto seed = uint64_t{0u};
+    auto count = uint64_t{0u};
+    if(!ReadValue(ifs, magic) || magic != file_magic || !ReadValue(ifs, version) || version != file_version || !ReadValue(ifs, seed) || !ReadValue(ifs, count)) {
+        return false;
+    }
+    std::vector<PlayerInput> frames{};
+    frames.reserve(static_cast<std::size_t>(count));
+    for(auto i = uint64_t{0u}; i < count; ++i) {
+        PlayerInput frame{};
+        auto has_ship = uint8_t{0u};
+        if(!ReadValue(ifs, frame.orientationDegrees) || !ReadValue(ifs, frame.fireOrientationDegrees) || !ReadValue(ifs, frame.fireVelocityX) || !ReadValue(ifs, frame.fireVelocityY) || !ReadValue(ifs, frame.thrust) || !ReadValue(ifs, frame.buttons) || !ReadValue(ifs, has_ship)) {
+            return false;
+        }
+        frame.hasShip = has_ship != 0u;
+        frames.push_back(frame);
+    }
+    m_seed = seed;
+    m_frames = std::move(frames);
+    return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+//What the player asked the ship to do during one frame. It is captured after
+//the devices, or the headless autopilot, have been read, so replaying it needs
+//neither.
+struct PlayerInput {
+    enum Button : uint8_t {
+        Button_None = 0u
+        , Button_Fire = 1u << 0
+        , Button_DropMine = 1u << 1
+        //With Button_Fire: the bullet left at fireVelocity rather than along the ship's aim.
+        , Button_FireAtVelocity = 1u << 2
+    };
+
+    //Where the ship pointed once input was handled.
+    float orientationDegrees{0.0f};
+    //Where it pointed when it first tried to fire; bullets leave along this.
+    float fireOrientationDegrees{0.0f};
+    //The lead velocity the autopilot fired at; only read with Button_FireAtVelocity.
+    float fireVelocityX{0.0f};
+    float fireVelocityY{0.0f};
+    float thrust{0.0f};
+    uint8_t buttons{Button_None};
+    //Frames without a ship are kept so frame numbers line up; nothing is replayed for them.
+    bool hasShip{false};
+};
+
+//Frame-by-frame PlayerInput for one run, together with the seed it was
+//recorded under. Together, the seed and the log reproduce the run exactly.
+class InputLog {
+public:
+    static inline constexpr const uint32_t file_version = 2u;
+
+    InputLog() noexcept = default;
+    InputLog(const InputLog& other) = default;
+    InputLog(InputLog&& other) noexcept = default;
+    InputLog& operator=(const InputLog& other) = default;
+    InputLog& operator=(InputLog&& other) noexcept = default;
+    ~InputLog() noexcept = default;
+
+    void Clear() noexcept;
+    void SetSeed(uint64_t seed) noexcept;
+    [[nodiscard]] uint64_t GetSeed() const noexcept;
+
+    void Reserve(std::size_t frames) noexcept;
+    void Append(const PlayerInput& input) noexcept;
+    //Playback: hands out the frames in order. False once they run out.
+    [[nodiscard]] bool Next(PlayerInput& input) noexcept;
+    void Rewind() noexcept;
+
+    [[nodiscard]] std::size_t Size() const noexcept;
+    [[nodiscard]] bool IsEmpty() const noexcept;
+
+    [[nodiscard]] bool SaveToFile(const std::filesystem::path& path) const noexcept;
+    [[nodiscard]] bool LoadFromFile(const std::filesystem::path& path) noexcept;
+
+protected:
+private:
+    uint64_t m_seed{0u};
+    std::vector<PlayerInput> m_frames{};
+    std::size_t m_cursor{0u};
+};
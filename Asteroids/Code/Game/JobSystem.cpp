@@ -0,0 +1,154 @@
+#include "Game/JobSystem.hpp"
+
+#include <algorithm>
+
+JobSystem::JobSystem(std::size_t workerCount) noexcept {
+    m_queues.reserve(workerCount + 1u);
+    for(std::size_t i = 0u; i <= workerCount; ++i) {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+    m_workers.reserve(workerCount);
+    for(std::size_t i = 1u; i <= workerCount; ++i) {
+        m_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() noexcept {
+    {
+        std::scoped_lock<std::mutex> lock(m_wake_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for(auto& worker : m_workers) {
+        if(worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void JobSystem::Run(std::size_t count, std::size_t grainSize, RangeRef body) noexcept {
+    grainSize = (std::max)(grainSize, std::size_t{1u});
+    const auto chunk_count = CalcChunkCount(count, grainSize);
+    if(m_workers.empty() || chunk_count < 2u) {
+        for(std::size_t chunk = 0u; chunk < chunk_count; ++chunk) {
+            const auto begin = chunk * grainSize;
+            body.call(body.object, chunk, begin, (std::min)(begin + grainSize, count));
+        }
+        return;
+    }
+    std::atomic<std::size_t> remaining{chunk_count};
+    for(std::size_t chunk = 0u; chunk < chunk_count; ++chunk) {
+        const auto begin = chunk * grainSize;
+        const auto end = (std::min)(begin + grainSize, count);
+        Push(chunk % m_queues.size(), Task{body, &remaining, chunk, begin, end});
+    }
+    {
+        //Taking the lock orders the pushes before any worker re-checks its wait predicate.
+        std::scoped_lock<std::mutex> lock(m_wake_mutex);
+    }
+    m_wake.notify_all();
+    Task task{};
+    while(remaining.load(std::memory_order_acquire) != 0u) {
+        if(TryTakeTask(0u, task)) {
+            Execute(task);
+        } else {
+            //Everything left is already running on a worker.
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::Execute(const Task& task) noexcept {
+    task.body.call(task.body.object, task.chunk, task.begin, task.end);
+    task.remaining->fetch_sub(1u, std::memory_order_release);
+}
+
+std::size_t JobSystem::GetWorkerCount() const noexcept {
+    return m_workers.size();
+}
+
+std::size_t JobSystem::CalcChunkCount(std::size_t count, std::size_t grainSize) noexcept {
+    grainSize = (std::max)(grainSize, std::size_t{1u});
+    return (count + grainSize - 1u) / grainSize;
+}
+
+std::size_t JobSystem::GetDefaultWorkerCount() noexcept {
+    const auto hardware_threads = static_cast<std::size_t>(std::thread::hardware_concurrency());
+    return hardware_threads > 1u ? hardware_threads - 1u : 0u;
+}
+
+void JobSystem::WorkerLoop(std::size_t queue) noexcept {
+    Task task{};
+    while(true) {
+        if(TryTakeTask(queue, task)) {
+            Execute(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_wake_mutex);
+        m_wake.wait(lock, [this] { return m_stop || m_queued_tasks.load(std::memory_order_acquire) != 0u; });
+        if(m_stop) {
+            return;
+        }
+    }
+}
+
+bool JobSystem::TryTakeTask(std::size_t queue, Task& task) noexcept {
+    {
+        auto& own = *m_queues[queue];
+        std::scoped_lock<std::mutex> lock(own.mutex);
+        if(own.PopBack(task)) {
+            m_queued_tasks.fetch_sub(1u, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    const auto queue_count = m_queues.size();
+    for(std::size_t i = 1u; i < queue_count; ++i) {
+        auto& victim = *m_queues[(queue + i) % queue_count];
+        std::scoped_lock<std::mutex> lock(victim.mutex);
+        if(victim.PopFront(task)) {
+            m_queued_tasks.fetch_sub(1u, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::Push(std::size_t queue, const Task& task) noexcept {
+    auto& target = *m_queues[queue];
+    std::scoped_lock<std::mutex> lock(target.mutex);
+    target.PushBack(task);
+    m_queued_tasks.fetch_add(1u, std::memory_order_release);
+}
+
+void JobSystem::Queue::PushBack(const Task& task) noexcept {
+    if(count == ring.size()) {
+        //Unrolled into the new ring from head, so the order survives the move.
+        std::vector<Task> grown((std::max)(ring.size() * 2u, initial_capacity));
+        for(std::size_t i = 0u; i < count; ++i) {
+            grown[i] = ring[(head + i) % ring.size()];
+        }
+        ring = std::move(grown);
+        head = 0u;
+    }
+    ring[(head + count) % ring.size()] = task;
+    ++count;
+}
+
+bool JobSystem::Queue::PopBack(Task& task) noexcept {
+    if(count == 0u) {
+        return false;
+    }
+    --count;
+    task = ring[(head + count) % ring.size()];
+    return true;
+}
+
+bool JobSystem::Queue::PopFront(Task& task) noexcept {
+    if(count == 0u) {
+        return false;
+    }
+    task = ring[head];
+    head = (head + 1u) % ring.size();
+    --count;
+    return true;
+}
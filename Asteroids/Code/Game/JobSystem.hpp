@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+//Fixed pool of worker threads, each with its own task deque. A worker pops
+//from the back of its own deque and, once that is empty, steals from the front
+//of the others, so an uneven split evens itself out. The thread that calls
+//ParallelFor joins in until the whole range is done.
+//Tasks are plain data in per-worker rings that only grow when a call queues
+//more than they have ever held, so a steady stream of ParallelFor calls does
+//not touch the heap.
+class JobSystem {
+public:
+    //workerCount does not include the calling thread; zero runs everything inline.
+    explicit JobSystem(std::size_t workerCount) noexcept;
+    JobSystem(const JobSystem& other) = delete;
+    JobSystem(JobSystem&& other) = delete;
+    JobSystem& operator=(const JobSystem& other) = delete;
+    JobSystem& operator=(JobSystem&& other) = delete;
+    ~JobSystem() noexcept;
+
+    //Splits [0, count) into chunks of at most grainSize and blocks until body has run on all of them.
+    //body is called as body(chunk, begin, end); begin and end index the range and chunk is the index
+    //of the [begin, end) chunk, which is the same for a given count and grain size no matter which
+    //thread runs it. body is only referenced, never copied.
+    template<typename Body>
+    void ParallelFor(std::size_t count, std::size_t grainSize, Body&& body) noexcept {
+        using body_type = std::remove_reference_t<Body>;
+        const auto call = [](void* object, std::size_t chunk, std::size_t begin, std::size_t end) {
+            (*static_cast<body_type*>(object))(chunk, begin, end);
+        };
+        Run(count, grainSize, RangeRef{const_cast<void*>(static_cast<const void*>(std::addressof(body))), call});
+    }
+
+    [[nodiscard]] std::size_t GetWorkerCount() const noexcept;
+    [[nodiscard]] static std::size_t CalcChunkCount(std::size_t count, std::size_t grainSize) noexcept;
+    //One less than the hardware threads, leaving a core for the calling thread.
+    [[nodiscard]] static std::size_t GetDefaultWorkerCount() noexcept;
+
+protected:
+private:
+    //Non-owning view of a ParallelFor body, which outlives its tasks because ParallelFor blocks.
+    struct RangeRef {
+        void* object{nullptr};
+        void (*call)(void* object, std::size_t chunk, std::size_t begin, std::size_t end){nullptr};
+    };
+
+    struct Task {
+        RangeRef body{};
+        std::atomic<std::size_t>* remaining{nullptr};
+        std::size_t chunk{0u};
+        std::size_t begin{0u};
+        std::size_t end{0u};
+    };
+
+    //Double-ended ring of tasks; callers hold mutex.
+    struct Queue {
+        static inline constexpr const std::size_t initial_capacity = 64u;
+
+        void PushBack(const Task& task) noexcept;
+        [[nodiscard]] bool PopBack(Task& task) noexcept;
+        [[nodiscard]] bool PopFront(Task& task) noexcept;
+
+        std::mutex mutex{};
+        std::vector<Task> ring = std::vector<Task>(initial_capacity);
+        std::size_t head{0u};
+        std::size_t count{0u};
+    };
+
+    void Run(std::size_t count, std::size_t grainSize, RangeRef body) noexcept;
+    static void Execute(const Task& task) noexcept;
+    void WorkerLoop(std::size_t queue) noexcept;
+    //Own queue first, then the others starting after it.
+    [[nodiscard]] bool TryTakeTask(std::size_t queue, Task& task) noexcept;
+    void Push(std::size_t queue, const Task& task) noexcept;
+
+    //Queue 0 belongs to whichever thread is calling ParallelFor.
+    std::vector<std::unique_ptr<Queue>> m_queues{};
+    std::vector<std::thread> m_workers{};
+    std::atomic<std::size_t> m_queued_tasks{0u};
+    std::mutex m_wake_mutex{};
+    std::condition_variable m_wake{};
+    bool m_stop{false};
+};
@@ -0,0 +1,306 @@
+#include "Game/KinematicsStore.hpp"
+
+#include "Engine/Math/MathUtils.hpp"
+
+#include "Game/GameEntity.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__) || defined(_M_X64) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+KinematicsStore::index_type KinematicsStore::Acquire(GameEntity* owner) noexcept {
+    const auto index = m_owners.size();
+    m_owners.push_back(owner);
+    position_x.push_back(0.0f);
+    position_y.push_back(0.0f);
+    orientation_degrees.push_back(0.0f);
+    previous_position_x.push_back(0.0f);
+    previous_position_y.push_back(0.0f);
+    previous_orientation_degrees.push_back(0.0f);
+    speed.push_back(0.0f);
+    direction_x.push_back(0.0f);
+    direction_y.push_back(0.0f);
+    acceleration_x.push_back(0.0f);
+    acceleration_y.push_back(0.0f);
+    force_x.push_back(0.0f);
+    force_y.push_back(0.0f);
+    cosmetic_radius.push_back(0.0f);
+    physical_radius.push_back(0.0f);
+    inverse_mass.push_back(1.0f);
+    rotation_speed.push_back(90.0f);
+    health.push_back(1.0f);
+    scale_x.push_back(1.0f);
+    scale_y.push_back(1.0f);
+    has_transform.push_back(0u);
+    transform.push_back(Matrix4::I);
+    return index;
+}
+
+void KinematicsStore::Release(index_type index) noexcept {
+    if(index >= m_owners.size()) {
+        return;
+    }
+    //Pending slots must stay behind the committed ones, so a committed hole is
+    //filled from the end of the committed range and that one from the very end.
+    if(index < m_committed_count) {
+        --m_committed_count;
+        FillSlot(m_committed_count, index);
+        index = m_committed_count;
+    }
+    FillSlot(m_owners.size() - 1, index);
+    PopSlot();
+}
+
+void KinematicsStore::Reserve(std::size_t count) noexcept {
+    m_owners.reserve(count);
+    position_x.reserve(count);
+    position_y.reserve(count);
+    orientation_degrees.reserve(count);
+    previous_position_x.reserve(count);
+    previous_position_y.reserve(count);
+    previous_orientation_degrees.reserve(count);
+    speed.reserve(count);
+    direction_x.reserve(count);
+    direction_y.reserve(count);
+    acceleration_x.reserve(count);
+    acceleration_y.reserve(count);
+    force_x.reserve(count);
+    force_y.reserve(count);
+    cosmetic_radius.reserve(count);
+    physical_radius.reserve(count);
+    inverse_mass.reserve(count);
+    rotation_speed.reserve(count);
+    health.reserve(count);
+    scale_x.reserve(count);
+    scale_y.reserve(count);
+    has_transform.reserve(count);
+    transform.reserve(count);
+}
+
+void KinematicsStore::CommitPending() noexcept {
+    m_committed_count = m_owners.size();
+}
+
+std::size_t KinematicsStore::Size() const noexcept {
+    return m_owners.size();
+}
+
+std::size_t KinematicsStore::CommittedSize() const noexcept {
+    return m_committed_count;
+}
+
+bool KinematicsStore::IsEmpty() const noexcept {
+    return m_owners.empty();
+}
+
+GameEntity* KinematicsStore::GetOwner(index_type index) const noexcept {
+    return m_owners[index];
+}
+
+Vector2 KinematicsStore::GetPosition(index_type index) const noexcept {
+    return Vector2{position_x[index], position_y[index]};
+}
+
+void KinematicsStore::SetPosition(index_type index, Vector2 newPosition) noexcept {
+    previous_position_x[index] += newPosition.x - position_x[index];
+    previous_position_y[index] += newPosition.y - position_y[index];
+    position_x[index] = newPosition.x;
+    position_y[index] = newPosition.y;
+}
+
+void KinematicsStore::SetOrientationDegrees(index_type index, float newDegrees) noexcept {
+    orientation_degrees[index] = newDegrees;
+    previous_orientation_degrees[index] = newDegrees;
+}
+
+void KinematicsStore::SnapshotPrevious() noexcept {
+    std::copy(std::cbegin(position_x), std::cend(position_x), std::begin(previous_position_x));
+    std::copy(std::cbegin(position_y), std::cend(position_y), std::begin(previous_position_y));
+    std::copy(std::cbegin(orientation_degrees), std::cend(orientation_degrees), std::begin(previous_orientation_degrees));
+}
+
+Vector2 KinematicsStore::CalcInterpolatedPosition(index_type index, float alpha) const noexcept {
+    const auto x = previous_position_x[index] + (position_x[index] - previous_position_x[index]) * alpha;
+    const auto y = previous_position_y[index] + (position_y[index] - previous_position_y[index]) * alpha;
+    return Vector2{x, y};
+}
+
+float KinematicsStore::CalcInterpolatedOrientationDegrees(index_type index, float alpha) const noexcept {
+    //Take the short way around so 359 -> 1 does not sweep through 180.
+    const auto delta = std::remainder(orientation_degrees[index] - previous_orientation_degrees[index], 360.0f);
+    return previous_orientation_degrees[index] + delta * alpha;
+}
+
+void KinematicsStore::Integrate(float deltaSeconds) noexcept {
+    index_type first = 0;
+    const auto last = CommittedSize();
+    IntegrateSimd(deltaSeconds, first, last);
+    IntegrateScalar(deltaSeconds, first, last);
+}
+
+void KinematicsStore::ClearForces() noexcept {
+    std::fill(std::begin(force_x), std::end(force_x), 0.0f);
+    std::fill(std::begin(force_y), std::end(force_y), 0.0f);
+}
+
+void KinematicsStore::CalcTransforms(index_type first, index_type last) noexcept {
+    for(auto i = first; i < last; ++i) {
+        if(!has_transform[i]) {
+            continue;
+        }
+        //The columns of S * R * T written out: scaled rotated basis vectors and the position.
+        const auto radians = MathUtils::ConvertDegreesToRadians(orientation_degrees[i]);
+        const auto c = std::cos(radians);
+        const auto s = std::sin(radians);
+        transform[i] = Matrix4{Vector2{c * scale_x[i], s * scale_x[i]}, Vector2{-s * scale_y[i], c * scale_y[i]}, Vector2{position_x[i], position_y[i]}};
+        if(auto* owner = m_owners[i]; owner != nullptr) {
+            owner->ApplyTransform(transform[i]);
+        }
+    }
+}
+
+void KinematicsStore::IntegrateScalar(float deltaSeconds, index_type first, index_type last) noexcept {
+    for(auto i = first; i < last; ++i) {
+        const auto ax = force_x[i] * inverse_mass[i];
+        const auto ay = force_y[i] * inverse_mass[i];
+        const auto vx = direction_x[i] * speed[i] + ax * deltaSeconds;
+        const auto vy = direction_y[i] * speed[i] + ay * deltaSeconds;
+        position_x[i] += vx * deltaSeconds;
+        position_y[i] += vy * deltaSeconds;
+        const auto length = std::sqrt(vx * vx + vy * vy);
+        speed[i] = length;
+        //A zero velocity has a heading of zero degrees, i.e. the +X axis.
+        direction_x[i] = length > 0.0f ? vx / length : 1.0f;
+        direction_y[i] = length > 0.0f ? vy / length : 0.0f;
+        acceleration_x[i] = ax;
+        acceleration_y[i] = ay;
+    }
+}
+
+#if defined(__AVX2__)
+
+void KinematicsStore::IntegrateSimd(float deltaSeconds, index_type& first, index_type last) noexcept {
+    const auto dt = _mm256_set1_ps(deltaSeconds);
+    const auto zero = _mm256_setzero_ps();
+    const auto one = _mm256_set1_ps(1.0f);
+    auto i = first;
+    for(; i + 8 <= last; i += 8) {
+        const auto invMass = _mm256_loadu_ps(&inverse_mass[i]);
+        const auto ax = _mm256_mul_ps(_mm256_loadu_ps(&force_x[i]), invMass);
+        const auto ay = _mm256_mul_ps(_mm256_loadu_ps(&force_y[i]), invMass);
+        const auto s = _mm256_loadu_ps(&speed[i]);
+        const auto vx = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&direction_x[i]), s), _mm256_mul_ps(ax, dt));
+        const auto vy = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&direction_y[i]), s), _mm256_mul_ps(ay, dt));
+        _mm256_storeu_ps(&position_x[i], _mm256_add_ps(_mm256_loadu_ps(&position_x[i]), _mm256_mul_ps(vx, dt)));
+        _mm256_storeu_ps(&position_y[i], _mm256_add_ps(_mm256_loadu_ps(&position_y[i]), _mm256_mul_ps(vy, dt)));
+        const auto length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)));
+        const auto moving = _mm256_cmp_ps(length, zero, _CMP_GT_OQ);
+        _mm256_storeu_ps(&speed[i], length);
+        _mm256_storeu_ps(&direction_x[i], _mm256_blendv_ps(one, _mm256_div_ps(vx, length), moving));
+        _mm256_storeu_ps(&direction_y[i], _mm256_blendv_ps(zero, _mm256_div_ps(vy, length), moving));
+        _mm256_storeu_ps(&acceleration_x[i], ax);
+        _mm256_storeu_ps(&acceleration_y[i], ay);
+    }
+    first = i;
+}
+
+#elif defined(_M_X64) || defined(__SSE2__)
+
+void KinematicsStore::IntegrateSimd(float deltaSeconds, index_type& first, index_type last) noexcept {
+    const auto dt = _mm_set1_ps(deltaSeconds);
+    const auto zero = _mm_setzero_ps();
+    const auto one = _mm_set1_ps(1.0f);
+    const auto select = [](__m128 mask, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); };
+    auto i = first;
+    for(; i + 4 <= last; i += 4) {
+        const auto invMass = _mm_loadu_ps(&inverse_mass[i]);
+        const auto ax = _mm_mul_ps(_mm_loadu_ps(&force_x[i]), invMass);
+        const auto ay = _mm_mul_ps(_mm_loadu_ps(&force_y[i]), invMass);
+        const auto s = _mm_loadu_ps(&speed[i]);
+        const auto vx = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&direction_x[i]), s), _mm_mul_ps(ax, dt));
+        const auto vy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&direction_y[i]), s), _mm_mul_ps(ay, dt));
+        _mm_storeu_ps(&position_x[i], _mm_add_ps(_mm_loadu_ps(&position_x[i]), _mm_mul_ps(vx, dt)));
+        _mm_storeu_ps(&position_y[i], _mm_add_ps(_mm_loadu_ps(&position_y[i]), _mm_mul_ps(vy, dt)));
+        const auto length = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)));
+        const auto moving = _mm_cmpgt_ps(length, zero);
+        _mm_storeu_ps(&speed[i], length);
+        _mm_storeu_ps(&direction_x[i], select(moving, _mm_div_ps(vx, length), one));
+        _mm_storeu_ps(&direction_y[i], select(moving, _mm_div_ps(vy, length), zero));
+        _mm_storeu_ps(&acceleration_x[i], ax);
+        _mm_storeu_ps(&acceleration_y[i], ay);
+    }
+    first = i;
+}
+
+#else
+
+void KinematicsStore::IntegrateSimd([[maybe_unused]] float deltaSeconds, [[maybe_unused]] index_type& first, [[maybe_unused]] index_type last) noexcept {
+    /* DO NOTHING */
+}
+
+#endif
+
+void KinematicsStore::MoveSlot(index_type from, index_type to) noexcept {
+    m_owners[to] = m_owners[from];
+    position_x[to] = position_x[from];
+    position_y[to] = position_y[from];
+    orientation_degrees[to] = orientation_degrees[from];
+    previous_position_x[to] = previous_position_x[from];
+    previous_position_y[to] = previous_position_y[from];
+    previous_orientation_degrees[to] = previous_orientation_degrees[from];
+    speed[to] = speed[from];
+    direction_x[to] = direction_x[from];
+    direction_y[to] = direction_y[from];
+    acceleration_x[to] = acceleration_x[from];
+    acceleration_y[to] = acceleration_y[from];
+    force_x[to] = force_x[from];
+    force_y[to] = force_y[from];
+    cosmetic_radius[to] = cosmetic_radius[from];
+    physical_radius[to] = physical_radius[from];
+    inverse_mass[to] = inverse_mass[from];
+    rotation_speed[to] = rotation_speed[from];
+    health[to] = health[from];
+    scale_x[to] = scale_x[from];
+    scale_y[to] = scale_y[from];
+    has_transform[to] = has_transform[from];
+    transform[to] = transform[from];
+}
+
+void KinematicsStore::FillSlot(index_type from, index_type to) noexcept {
+    if(from == to) {
+        return;
+    }
+    MoveSlot(from, to);
+    if(auto* moved = m_owners[to]; moved != nullptr) {
+        moved->m_kinematics_index = to;
+    }
+}
+
+void KinematicsStore::PopSlot() noexcept {
+    m_owners.pop_back();
+    position_x.pop_back();
+    position_y.pop_back();
+    orientation_degrees.pop_back();
+    previous_position_x.pop_back();
+    previous_position_y.pop_back();
+    previous_orientation_degrees.pop_back();
+    speed.pop_back();
+    direction_x.pop_back();
+    direction_y.pop_back();
+    acceleration_x.pop_back();
+    acceleration_y.pop_back();
+    force_x.pop_back();
+    force_y.pop_back();
+    cosmetic_radius.pop_back();
+    physical_radius.pop_back();
+    inverse_mass.pop_back();
+    rotation_speed.pop_back();
+    health.pop_back();
+    scale_x.pop_back();
+    scale_y.pop_back();
+    has_transform.pop_back();
+    transform.pop_back();
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Engine/Math/Matrix4.hpp"
+#include "Engine/Math/Vector2.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class GameEntity;
+
+//Structure-of-arrays storage for the per-entity physics state.
+//Every live GameEntity owns exactly one slot; slots are kept dense
+//by swapping the last slot into any released one.
+//New slots start out pending and sit behind the committed ones until
+//CommitPending; only committed slots are integrated.
+class KinematicsStore {
+public:
+    using index_type = std::size_t;
+    static inline constexpr const index_type invalid_index = static_cast<index_type>(-1);
+
+    KinematicsStore() noexcept = default;
+    KinematicsStore(const KinematicsStore& other) = delete;
+    KinematicsStore(KinematicsStore&& other) = delete;
+    KinematicsStore& operator=(const KinematicsStore& other) = delete;
+    KinematicsStore& operator=(KinematicsStore&& other) = delete;
+    ~KinematicsStore() noexcept = default;
+
+    [[nodiscard]] index_type Acquire(GameEntity* owner) noexcept;
+    void Release(index_type index) noexcept;
+    void Reserve(std::size_t count) noexcept;
+
+    //Marks every pending slot as part of the world.
+    void CommitPending() noexcept;
+
+    [[nodiscard]] std::size_t Size() const noexcept;
+    [[nodiscard]] std::size_t CommittedSize() const noexcept;
+    [[nodiscard]] bool IsEmpty() const noexcept;
+
+    [[nodiscard]] GameEntity* GetOwner(index_type index) const noexcept;
+    [[nodiscard]] Vector2 GetPosition(index_type index) const noexcept;
+    //Shifts the previous position by the same offset so wraps and spawns are not interpolated across.
+    void SetPosition(index_type index, Vector2 newPosition) noexcept;
+    void SetOrientationDegrees(index_type index, float newDegrees) noexcept;
+
+    //Records the current pose of every slot as the start of the next simulation tick.
+    void SnapshotPrevious() noexcept;
+    [[nodiscard]] Vector2 CalcInterpolatedPosition(index_type index, float alpha) const noexcept;
+    [[nodiscard]] float CalcInterpolatedOrientationDegrees(index_type index, float alpha) const noexcept;
+
+    //Integrates force into acceleration, velocity and position for every committed
+    //slot and re-normalizes the velocity direction without a heading round-trip.
+    void Integrate(float deltaSeconds) noexcept;
+    void IntegrateScalar(float deltaSeconds, index_type first, index_type last) noexcept;
+    //Forces only last for the tick they were added in.
+    void ClearForces() noexcept;
+    //Builds the scale-rotate-translate world transform of every slot in [first, last)
+    //whose owner asked for one, from a single sin/cos per slot and no matrix
+    //products, and hands it to the owner. Run after every Update of the tick.
+    void CalcTransforms(index_type first, index_type last) noexcept;
+
+    std::vector<float> position_x{};
+    std::vector<float> position_y{};
+    std::vector<float> orientation_degrees{};
+    std::vector<float> previous_position_x{};
+    std::vector<float> previous_position_y{};
+    std::vector<float> previous_orientation_degrees{};
+    std::vector<float> speed{};
+    std::vector<float> direction_x{};
+    std::vector<float> direction_y{};
+    std::vector<float> acceleration_x{};
+    std::vector<float> acceleration_y{};
+    std::vector<float> force_x{};
+    std::vector<float> force_y{};
+    std::vector<float> cosmetic_radius{};
+    std::vector<float> physical_radius{};
+    std::vector<float> inverse_mass{};
+    std::vector<float> rotation_speed{};
+    std::vector<float> health{};
+    //Written by GameEntity::UpdateTransform, read by CalcTransforms.
+    std::vector<float> scale_x{};
+    std::vector<float> scale_y{};
+    std::vector<uint8_t> has_transform{};
+    std::vector<Matrix4> transform{};
+protected:
+private:
+    void IntegrateSimd(float deltaSeconds, index_type& first, index_type last) noexcept;
+    void MoveSlot(index_type from, index_type to) noexcept;
+    void FillSlot(index_type from, index_type to) noexcept;
+    void PopSlot() noexcept;
+
+    std::vector<GameEntity*> m_owners{};
+    std::size_t m_committed_count{0u};
+};
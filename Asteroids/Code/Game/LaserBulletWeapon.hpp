@@ -2,7 +2,7 @@
 
 #include "Game/IWeapon.hpp"
 
-#include "Engine/Core/Stopwatch.hpp"
+#include "Game/SimStopwatch.hpp"
 
 class LaserBulletWeapon : public IWeapon {
 public:
@@ -26,8 +26,8 @@ public:
 protected:
 private:
     WeaponDesc m_desc{};
-    Stopwatch m_fireDelay{};
-    Stopwatch m_fireRate{};
+    SimStopwatch m_fireDelay{};
+    SimStopwatch m_fireRate{};
     bool m_canFire{false};
     bool m_canSpawnBullet{false};
 };
@@ -15,32 +15,87 @@
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/Material.hpp"
 
+#include "Engine/Services/ServiceLocator.hpp"
+#include "Engine/Services/IRendererService.hpp"
+
 #include "Engine/UI/UISystem.hpp"
 
 #include "Game/Game.hpp"
+#include "Game/CollisionResponse.hpp"
+#include "Game/EntityPool.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/GameConfig.hpp"
+#include "Game/HeadlessRunner.hpp"
 #include "Game/Ship.hpp"
 #include "Game/Asteroid.hpp"
 #include "Game/Bullet.hpp"
 #include "Game/Explosion.hpp"
 #include "Game/Mine.hpp"
+#include "Game/SimStopwatch.hpp"
+#include "Game/UnitQuad.hpp"
 
 #include "Game/TitleState.hpp"
 #include "Game/GameOverState.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <format>
 #include <utility>
 
+namespace {
+
+//Adds the lifetime of the scope to one frame phase total.
+class ScopedPhaseTimer {
+public:
+    explicit ScopedPhaseTimer(MainState::FramePhaseTimes& times, MainState::FramePhase phase) noexcept
+    : m_total(times[static_cast<std::size_t>(phase)])
+    , m_start(std::chrono::steady_clock::now())
+    {
+        /* DO NOTHING */
+    }
+    ScopedPhaseTimer(const ScopedPhaseTimer& other) = delete;
+    ScopedPhaseTimer(ScopedPhaseTimer&& other) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer& other) = delete;
+    ScopedPhaseTimer& operator=(ScopedPhaseTimer&& other) = delete;
+    ~ScopedPhaseTimer() noexcept {
+        m_total += std::chrono::duration_cast<TimeUtils::FPSeconds>(std::chrono::steady_clock::now() - m_start);
+    }
+private:
+    TimeUtils::FPSeconds& m_total;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+[[nodiscard]] bool DoesDiscOverlapBounds(Vector2 center, float radius, const AABB2& bounds) noexcept {
+    return center.x + radius >= bounds.mins.x && center.x - radius <= bounds.maxs.x
+        && center.y + radius >= bounds.mins.y && center.y - radius <= bounds.maxs.y;
+}
+
+} // namespace
+
 void MainState::OnEnter() noexcept {
     m_Scene = std::make_shared<Scene>();
     m_world_bounds = AABB2::Zero_to_One;
-    auto dims = Vector2{g_theRenderer->GetOutput()->GetDimensions()};
+    const auto is_headless = GetGameAs<Game>() && GetGameAs<Game>()->IsHeadless();
+    auto dims = is_headless ? Vector2{HeadlessRunner::worldWidth, HeadlessRunner::worldHeight} : Vector2{g_theRenderer->GetOutput()->GetDimensions()};
     //TODO: Fix world dims
     m_world_bounds.ScalePadding(dims.x, dims.y);
     m_world_bounds.Translate(-m_world_bounds.CalcCenter());
 
+    m_sim_accumulator = TimeUtils::FPSeconds{0.0f};
+    m_hud.Invalidate();
+    if(auto* game = GetGameAs<Game>(); game != nullptr) {
+        m_sim_step = game->GetSimulationStep();
+        //Everything random in a run derives from this one seed.
+        GameEntity::BeginRun(game->GetRunSeed());
+        SimStopwatch::ResetClock();
+        //Game outlives the run, so its timer still counts from the last one.
+        game->respawnTimer.Reset();
+        m_spawn_rng.Seed(game->GetRunSeed(), static_cast<uint64_t>(RandomStream::Subsystem::Spawning));
+        m_render_snapshots.SetThreaded(game->IsRenderThreaded());
+        m_capture_render_snapshots = !game->IsHeadless();
+    }
+
     m_cameraController = OrthographicCameraController{};
     m_cameraController.SetPosition(m_world_bounds.CalcCenter());
     m_cameraController.SetZoomLevelRange(Vector2{225.0f, 450.0f});
@@ -50,8 +105,9 @@ void MainState::OnEnter() noexcept {
     playerDesc.lives = GetLivesFromDifficulty();
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
         game->player = Player{playerDesc};
-
-        game->particleSystem->RegisterEffectsFromFolder(FileUtils::GetKnownFolderPath(FileUtils::KnownPathID::GameData) / "ParticleEffects");
+        if(!is_headless) {
+            game->particleSystem->RegisterEffectsFromFolder(FileUtils::GetKnownFolderPath(FileUtils::KnownPathID::GameData) / "ParticleEffects");
+        }
     }
     MakeShip();
 }
@@ -67,22 +123,24 @@ void MainState::OnExit() noexcept {
     //auto* group = g_theAudioSystem->GetChannelGroup(g_audiogroup_sound);
     //group->Stop();
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        asteroids.clear();
-        asteroids.shrink_to_fit();
-        bullets.clear();
-        bullets.shrink_to_fit();
-        explosions.clear();
-        explosions.shrink_to_fit();
-        ufos.clear();
-        ufos.shrink_to_fit();
+        asteroids.Clear();
+        bullets.Clear();
+        explosions.Clear();
+        ufos.Clear();
+        mines.Clear();
         m_entities.clear();
         m_entities.shrink_to_fit();
+        //Anything still queued was asked for by entities that no longer exist.
+        game->GetSpawnQueue().Clear();
         m_current_wave = 1u;
         ship = nullptr;
     }
 }
 
 void MainState::BeginFrame() noexcept {
+    m_heap_allocations_last_frame = AllocationCounter::GetSince(m_allocations_at_frame_begin).allocations;
+    m_allocations_at_frame_begin = AllocationCounter::GetTotals();
+    m_phase_times.fill(TimeUtils::FPSeconds{0.0f});
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
         game->SetControlType();
         for(auto& entity : m_entities) {
@@ -103,10 +161,37 @@ void MainState::Update([[maybe_unused]] TimeUtils::FPSeconds deltaSeconds) {
         if(game->IsPaused()) {
             deltaSeconds = deltaSeconds.zero();
         }
-        g_theRenderer->UpdateGameTime(deltaSeconds);
-        HandleDebugInput(deltaSeconds);
-        HandlePlayerInput(deltaSeconds);
-        UpdateEntities(deltaSeconds);
+        ServiceLocator::get<IRendererService>()->UpdateGameTime(deltaSeconds);
+        if(m_input_playback) {
+            //A replay stands in for every input source, devices and autopilot alike.
+            ReplayPlayerInput();
+        } else if(game->IsHeadless()) {
+            //No input devices; keep the player shooting so collisions and splits get exercised.
+            FireAtClosestAsteroidToPlayer(deltaSeconds);
+        } else {
+            HandleDebugInput(deltaSeconds);
+            HandlePlayerInput(deltaSeconds);
+        }
+        if(m_input_recording) {
+            m_input_recording->Append(ship ? ship->GetFrameInput() : PlayerInput{});
+        }
+        if(game->IsHeadless()) {
+            //The runner already steps at the simulation rate; one call is one tick.
+            TickSimulation(deltaSeconds);
+        } else {
+            m_sim_accumulator += deltaSeconds;
+            int steps = 0;
+            while(m_sim_accumulator >= m_sim_step && steps < max_sim_steps_per_frame) {
+                TickSimulation(m_sim_step);
+                m_sim_accumulator -= m_sim_step;
+                ++steps;
+            }
+            //Drop whatever could not be caught up instead of carrying it into the next frame.
+            if(m_sim_accumulator >= m_sim_step) {
+                m_sim_accumulator = TimeUtils::FPSeconds{std::fmod(m_sim_accumulator.count(), m_sim_step.count())};
+            }
+            GameEntity::SetRenderInterpolation(m_sim_accumulator / m_sim_step);
+        }
 
         if(game->IsGameOver()) {
             if(DoFadeOut(deltaSeconds)) {
@@ -115,6 +200,12 @@ void MainState::Update([[maybe_unused]] TimeUtils::FPSeconds deltaSeconds) {
         }
 
         m_cameraController.Update(deltaSeconds);
+
+        if(m_capture_render_snapshots) {
+            auto& snapshot = m_render_snapshots.BeginCapture();
+            CaptureRenderSnapshot(snapshot, game->IsHeadless() ? m_world_bounds : game->CalcCullBounds(m_cameraController));
+            m_render_snapshots.Publish();
+        }
     }
 }
 
@@ -127,16 +218,28 @@ void MainState::Render() const noexcept {
     g_theRenderer->SetViewportAsPercent();
 
     RenderBackground();
-    RenderEntities();
-    DebugRenderEntities();
-    RenderStatus();
-    RenderFadeOutOverlay();
-    RenderPausedOverlay();
+    const auto* snapshot = m_render_snapshots.AcquireForDraw();
+    if(snapshot == nullptr) {
+        return;
+    }
+    {
+        ScopedPhaseTimer timer{m_phase_times, FramePhase::RenderBuild};
+        //Particle effects live in the engine and are not part of the snapshot,
+        //so they bypass the backend and are missing from recorded draws.
+        if(ship) {
+            ship->Render();
+        }
+        RenderEntities(*snapshot, m_device_backend);
+    }
+    DebugRenderEntities(*snapshot);
+    RenderStatus(*snapshot);
+    RenderFadeOutOverlay(*snapshot);
+    RenderPausedOverlay(*snapshot);
 }
 
-void MainState::RenderFadeOutOverlay() const noexcept {
+void MainState::RenderFadeOutOverlay(const RenderSnapshot& snapshot) const noexcept {
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        if(!game->IsGameOver()) {
+        if(!snapshot.hud.gameOver) {
             return;
         }
         const auto ui_view_height = static_cast<float>(game->gameOptions.GetWindowHeight());
@@ -149,7 +252,7 @@ void MainState::RenderFadeOutOverlay() const noexcept {
         const auto M = Matrix4::MakeSRT(S, R, T);
         g_theRenderer->SetModelMatrix(M);
         g_theRenderer->SetMaterial("__2D");
-        g_theRenderer->DrawQuad2D(Rgba{0.0f, 0.0f, 0.0f, m_fadeOut_alpha});
+        g_theRenderer->DrawQuad2D(Rgba{0.0f, 0.0f, 0.0f, snapshot.hud.fadeOutAlpha});
     }
 }
 
@@ -160,12 +263,6 @@ void MainState::EndFrame() noexcept {
                 entity->EndFrame();
             }
         }
-        for(auto& entity : m_entities) {
-            if(entity && entity->IsDead()) {
-                entity->OnDestroy();
-                entity.reset();
-            }
-        }
         PostFrameCleanup();
     }
 }
@@ -314,6 +411,24 @@ void MainState::HandleDebugKeyboardInput([[maybe_unused]] TimeUtils::FPSeconds d
     if(g_theInputSystem->WasKeyJustPressed(KeyCode::Semicolon)) {
         KillAll();
     }
+    if(g_theInputSystem->WasKeyJustPressed(KeyCode::F6)) {
+        m_debug_draw.Toggle(DebugDrawBatch::Category::Radii);
+    }
+    if(g_theInputSystem->WasKeyJustPressed(KeyCode::F7)) {
+        m_debug_draw.Toggle(DebugDrawBatch::Category::Motion);
+    }
+    if(g_theInputSystem->WasKeyJustPressed(KeyCode::F8)) {
+        m_debug_draw.Toggle(DebugDrawBatch::Category::Camera);
+    }
+    if(g_theInputSystem->WasKeyJustPressed(KeyCode::F9)) {
+        m_debug_draw.Toggle(DebugDrawBatch::Category::Bounds);
+    }
+    if(g_theInputSystem->WasKeyJustPressed(KeyCode::F5)) {
+        if(auto* game = GetGameAs<Game>(); game != nullptr) {
+            m_render_snapshots.Discard();
+            game->ReloadMaterials();
+        }
+    }
     if (g_theInputSystem->IsKeyDown(KeyCode::SingleQuote)) {
         FireAtClosestAsteroidToPlayer(deltaSeconds);
 
@@ -321,7 +436,7 @@ void MainState::HandleDebugKeyboardInput([[maybe_unused]] TimeUtils::FPSeconds d
 #endif
 }
 
-void MainState::FireAtClosestAsteroid(TimeUtils::FPSeconds deltaSeconds, GameEntity* entity) const noexcept {
+void MainState::FireAtClosestAsteroid(TimeUtils::FPSeconds deltaSeconds, Ship* entity) const noexcept {
     if (const auto* a = GetClosestAsteroidToEntity(entity); a != nullptr) {
         const auto weaponProjectileSpeed = entity->GetWeapon()->GetSpeed();
         auto vel = Vector2::X_Axis * weaponProjectileSpeed;
@@ -336,11 +451,8 @@ void MainState::FireAtClosestAsteroid(TimeUtils::FPSeconds deltaSeconds, GameEnt
             const auto newAngle = (newPos - entity->GetPosition()).CalcHeadingDegrees();
             //Lead the target
             entity->SetOrientationDegrees(newAngle);
-            //Fire
-            entity->OnFire();
-            if(!bullets.empty()) {
-                bullets.back()->SetVelocity(newVelocity);
-            }
+            //Fire; the bullet is spawned later from the queue, so it has to be asked for at the lead velocity.
+            entity->OnFire(newVelocity);
         }
     }
 }
@@ -373,6 +485,52 @@ void MainState::FireAtPlayer(TimeUtils::FPSeconds deltaSeconds, GameEntity* enti
     }
 }
 
+void MainState::ReplayPlayerInput() noexcept {
+    PlayerInput input{};
+    if(m_input_playback->Next(input) && input.hasShip && ship) {
+        ship->ReplayInput(input);
+    }
+}
+
+void MainState::SetInputRecording(InputLog* log) noexcept {
+    m_input_recording = log;
+}
+
+void MainState::SetInputPlayback(InputLog* log) noexcept {
+    m_input_playback = log;
+}
+
+uint64_t MainState::CalcStateHash() const noexcept {
+    //FNV-1a over everything that decides how the run goes on from here.
+    uint64_t hash = 14695981039346656037ull;
+    const auto mix = [&hash](const auto& value) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+        for(std::size_t i = 0u; i < sizeof(value); ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    mix(m_current_wave);
+    mix(SimStopwatch::GetClock().count());
+    if(auto* game = GetGameAs<Game>(); game != nullptr) {
+        mix(game->player.GetScore());
+        mix(game->player.GetLives());
+    }
+    mix(m_entities.size());
+    const auto& store = GameEntity::GetKinematicsStore();
+    for(const auto& entity : m_entities) {
+        if(!entity) {
+            continue;
+        }
+        const auto i = entity->GetKinematicsIndex();
+        mix(entity->kind);
+        for(const auto value : {store.position_x[i], store.position_y[i], store.orientation_degrees[i], store.speed[i], store.direction_x[i], store.direction_y[i], store.health[i]}) {
+            mix(value);
+        }
+    }
+    return hash;
+}
+
 void MainState::HandlePlayerInput([[maybe_unused]] TimeUtils::FPSeconds deltaSeconds) {
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
         if(auto kb_state = HandleKeyboardInput(deltaSeconds)) {
@@ -387,13 +545,14 @@ void MainState::HandlePlayerInput([[maybe_unused]] TimeUtils::FPSeconds deltaSec
     }
 }
 
-void MainState::WrapAroundWorld(GameEntity* e) noexcept {
+void MainState::WrapAroundWorld(KinematicsStore::index_type index) noexcept {
+    auto& store = GameEntity::GetKinematicsStore();
     const auto world_left = m_world_bounds.mins.x;
     const auto world_right = m_world_bounds.maxs.x;
     const auto world_top = m_world_bounds.mins.y;
     const auto world_bottom = m_world_bounds.maxs.y;
-    const auto r = e->GetCosmeticRadius();
-    auto pos = e->GetPosition();
+    const auto r = store.cosmetic_radius[index];
+    auto pos = store.GetPosition(index);
     const auto entity_right = pos.x + r;
     const auto entity_left = pos.x - r;
     const auto entity_top = pos.y - r;
@@ -413,27 +572,111 @@ void MainState::WrapAroundWorld(GameEntity* e) noexcept {
     if(entity_top > world_bottom) {
         pos.y -= d + world_height;
     }
-    e->SetPosition(pos);
+    store.SetPosition(index, pos);
+}
+
+void MainState::GatherKinematicsIndices() noexcept {
+    const auto gather = [](const auto& entities, std::vector<KinematicsStore::index_type>& indices) {
+        indices.clear();
+        indices.reserve(entities.size());
+        for(const auto* e : entities) {
+            indices.push_back(e->GetKinematicsIndex());
+        }
+    };
+    gather(asteroids, m_asteroid_indices);
+    gather(bullets, m_bullet_indices);
+    gather(ufos, m_ufo_indices);
+    gather(mines, m_mine_indices);
+}
+
+void MainState::RebuildBroadphase() noexcept {
+    const auto& store = GameEntity::GetKinematicsStore();
+    m_asteroid_hash.Rebuild(m_world_bounds, store, m_asteroid_indices);
+    m_bullet_hash.Rebuild(m_world_bounds, store, m_bullet_indices);
+    m_ufo_hash.Rebuild(m_world_bounds, store, m_ufo_indices);
+    m_collision_pair_tests = 0u;
+}
+
+std::size_t MainState::GetCollisionPairTestCount() const noexcept {
+    return m_collision_pair_tests;
+}
+
+const MainState::FramePhaseTimes& MainState::GetFramePhaseTimes() const noexcept {
+    return m_phase_times;
 }
 
 void MainState::UpdateEntities(TimeUtils::FPSeconds deltaSeconds) noexcept {
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
+        ScopedPhaseTimer timer{m_phase_times, FramePhase::Update};
         if(IsWaveComplete()) {
             StartNewWave(m_current_wave++);
         }
+        auto& store = GameEntity::GetKinematicsStore();
+        auto& jobs = game->GetJobSystem();
+        //Every index only writes its own slot.
+        jobs.ParallelFor(store.CommittedSize(), wrap_grain_size, [this](std::size_t /*chunk*/, std::size_t begin, std::size_t end) {
+            for(auto i = begin; i != end; ++i) {
+                WrapAroundWorld(static_cast<KinematicsStore::index_type>(i));
+            }
+        });
+        store.Integrate(deltaSeconds.count());
+        //One spawn lane per chunk keeps spawns in the same order however the
+        //chunks were spread over the threads. They are created at cleanup.
+        auto& spawns = game->GetSpawnQueue();
+        spawns.ReserveLanes(JobSystem::CalcChunkCount(m_entities.size(), update_grain_size));
+        jobs.ParallelFor(m_entities.size(), update_grain_size, [this, &spawns, deltaSeconds](std::size_t chunk, std::size_t begin, std::size_t end) {
+            SpawnQueue::ScopedLane lane{spawns, chunk};
+            for(auto i = begin; i != end; ++i) {
+                if(auto& entity = m_entities[i]; entity && entity->CanUpdateInParallel()) {
+                    entity->Update(deltaSeconds);
+                }
+            }
+        });
         for(auto& entity : m_entities) {
-            if(entity) {
-                WrapAroundWorld(entity.get());
+            if(entity && !entity->CanUpdateInParallel()) {
                 entity->Update(deltaSeconds);
             }
         }
+        //Last, so every Update's scale and orientation are in.
+        jobs.ParallelFor(store.CommittedSize(), transform_grain_size, [&store](std::size_t /*chunk*/, std::size_t begin, std::size_t end) {
+            store.CalcTransforms(static_cast<KinematicsStore::index_type>(begin), static_cast<KinematicsStore::index_type>(end));
+        });
+    }
+    {
+        ScopedPhaseTimer timer{m_phase_times, FramePhase::Broadphase};
+        GatherKinematicsIndices();
+        RebuildBroadphase();
+    }
+    {
+        ScopedPhaseTimer timer{m_phase_times, FramePhase::BulletCollision};
+        HandleBulletCollision();
+    }
+    {
+        ScopedPhaseTimer timer{m_phase_times, FramePhase::ShipCollision};
+        HandleShipCollision();
+    }
+    {
+        ScopedPhaseTimer timer{m_phase_times, FramePhase::MineCollision};
+        HandleMineCollision();
     }
-    HandleBulletCollision();
-    HandleShipCollision();
-    HandleMineCollision();
     ClampCameraToWorld();
 }
 
+void MainState::TickSimulation(TimeUtils::FPSeconds step) noexcept {
+    auto& store = GameEntity::GetKinematicsStore();
+    store.SnapshotPrevious();
+    SimStopwatch::AdvanceClock(step);
+    //Input is sampled once per frame, but its forces act on each tick of it
+    //so thrust does not depend on how many ticks a frame happens to run.
+    if(ship) {
+        ship->ApplyThrust();
+    }
+    UpdateEntities(step);
+    store.ClearForces();
+    //Dead entities must not collide again on the next tick of the same frame.
+    PostFrameCleanup();
+}
+
 void MainState::StartNewWave(unsigned int wave_number) noexcept {
     for(unsigned int i = 0; i < wave_number * GetWaveMultiplierFromDifficulty(); ++i) {
         MakeLargeAsteroidOffScreen(m_world_bounds);
@@ -441,15 +684,15 @@ void MainState::StartNewWave(unsigned int wave_number) noexcept {
 }
 
 void MainState::MakeLargeAsteroidOffScreen(AABB2 world_bounds) noexcept {
-    const auto pos = [world_bounds]()->const Vector2 {
+    const auto pos = [this, world_bounds]()->const Vector2 {
         const auto world_dims = world_bounds.CalcDimensions();
         const auto world_width = world_dims.x;
         const auto world_height = world_dims.y;
-        const auto left = Vector2{world_bounds.mins.x - Asteroid::largeAsteroidCosmeticSize - 1.0f, MathUtils::GetRandomNegOneToOne<float>() * world_height};
-        const auto right = Vector2{world_bounds.maxs.x + Asteroid::largeAsteroidCosmeticSize + 1.0f, MathUtils::GetRandomNegOneToOne<float>() * world_height};
-        const auto top = Vector2{MathUtils::GetRandomNegOneToOne<float>() * world_width, world_bounds.mins.y - Asteroid::largeAsteroidCosmeticSize - 1.0f};
-        const auto bottom = Vector2{MathUtils::GetRandomNegOneToOne<float>() * world_width, world_bounds.maxs.y + Asteroid::largeAsteroidCosmeticSize + 1.0f };
-        const auto i = MathUtils::GetRandomLessThan(4);
+        const auto left = Vector2{world_bounds.mins.x - Asteroid::largeAsteroidCosmeticSize - 1.0f, m_spawn_rng.GetNegOneToOne<float>() * world_height};
+        const auto right = Vector2{world_bounds.maxs.x + Asteroid::largeAsteroidCosmeticSize + 1.0f, m_spawn_rng.GetNegOneToOne<float>() * world_height};
+        const auto top = Vector2{m_spawn_rng.GetNegOneToOne<float>() * world_width, world_bounds.mins.y - Asteroid::largeAsteroidCosmeticSize - 1.0f};
+        const auto bottom = Vector2{m_spawn_rng.GetNegOneToOne<float>() * world_width, world_bounds.maxs.y + Asteroid::largeAsteroidCosmeticSize + 1.0f };
+        const auto i = m_spawn_rng.GetLessThan(4u);
         switch(i) {
         case 0:
             return left;
@@ -467,145 +710,44 @@ void MainState::MakeLargeAsteroidOffScreen(AABB2 world_bounds) noexcept {
 }
 
 void MainState::MakeLargeAsteroidAt(Vector2 pos) noexcept {
-    const auto vx = MathUtils::GetRandomNegOneToOne<float>();
-    const auto vy = MathUtils::GetRandomNegOneToOne<float>();
-    const auto s = MathUtils::GetRandomInRange<float>(20.0f, 100.0f);
+    const auto vx = m_spawn_rng.GetNegOneToOne<float>();
+    const auto vy = m_spawn_rng.GetNegOneToOne<float>();
+    const auto s = m_spawn_rng.GetInRange<float>(20.0f, 100.0f);
     const auto vel = Vector2{vx, vy} *s;
-    const auto rot = MathUtils::GetRandomNegOneToOne<float>() * 180.0f;
+    const auto rot = m_spawn_rng.GetNegOneToOne<float>() * 180.0f;
     MakeLargeAsteroid(pos, vel, rot);
 }
 
 void MainState::MakeLargeAsteroid(Vector2 pos, Vector2 vel, float rotationSpeed) noexcept {
-    if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        game->SetAsteroidSpriteSheet();
-    }
-    auto newAsteroid = std::make_unique<Asteroid>(m_Scene->get(), Asteroid::Type::Large, pos, vel, rotationSpeed);
-    AddNewAsteroidToWorld(std::move(newAsteroid));
-}
-
-void MainState::MakeMediumAsteroid(Vector2 pos, Vector2 vel, float rotationSpeed) noexcept {
-    if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        game->SetAsteroidSpriteSheet();
-    }
-
-    auto newAsteroid = std::make_unique<Asteroid>(m_Scene, Asteroid::Type::Medium, pos, vel, rotationSpeed);
-    AddNewAsteroidToWorld(std::move(newAsteroid));
-}
-
-void MainState::MakeSmallAsteroid(Vector2 pos, Vector2 vel, float rotationSpeed) noexcept {
-    if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        game->SetAsteroidSpriteSheet();
-    }
-
-    auto newAsteroid = std::make_unique<Asteroid>(m_Scene, Asteroid::Type::Small, pos, vel, rotationSpeed);
-    AddNewAsteroidToWorld(std::move(newAsteroid));
+    RequestSpawn(SpawnRequest::ForAsteroid(static_cast<uint8_t>(Asteroid::Type::Large), pos, vel, rotationSpeed));
 }
 
 void MainState::DestroyAsteroid(Asteroid* pAsteroid) noexcept {
     if(pAsteroid && pAsteroid->IsDead()) {
-        if(auto iter = std::find(std::begin(asteroids), std::end(asteroids), pAsteroid); iter != std::end(asteroids)) {
-            *iter = nullptr;
-        }
+        asteroids.Remove(pAsteroid->GetHandle());
     }
 }
 
-void MainState::AddNewAsteroidToWorld(std::unique_ptr<Asteroid> newAsteroid) {
-    auto* last_entity = newAsteroid.get();
-    m_pending_entities.emplace_back(std::move(newAsteroid));
-    auto* asAsteroid = reinterpret_cast<Asteroid*>(last_entity);
-    asteroids.push_back(asAsteroid);
-    asAsteroid->OnCreate();
-}
-
 Ship* MainState::GetShip() const noexcept {
     return ship;
 }
 
-void MainState::MakeExplosion(Vector2 position) noexcept {
-    if (auto* game = GetGameAs<Game>(); game) {
-        game->SetExplosionSpriteSheet();
-    }
-    auto newExplosion = std::make_unique<Explosion>(m_Scene, position);
-    auto* last_entity = newExplosion.get();
-    m_pending_entities.emplace_back(std::move(newExplosion));
-    auto* asExplosion = reinterpret_cast<Explosion*>(last_entity);
-    explosions.push_back(asExplosion);
-    asExplosion->OnCreate();
-}
-
 void MainState::DestroyExplosion(Explosion* pExplosion) noexcept {
     if(pExplosion && pExplosion->IsDead()) {
-        if(auto iter = std::find(std::begin(explosions), std::end(explosions), pExplosion); iter != std::end(explosions)) {
-            *iter = nullptr;
-        }
+        explosions.Remove(pExplosion->GetHandle());
     }
 }
 
-void MainState::MakeBullet(const GameEntity* parent, Vector2 pos, Vector2 vel) noexcept {
-    auto newBullet = std::make_unique<Bullet>(m_Scene, parent, pos, vel);
-    auto* last_entity = newBullet.get();
-    m_pending_entities.emplace_back(std::move(newBullet));
-    auto* asBullet = reinterpret_cast<Bullet*>(last_entity);
-    bullets.push_back(asBullet);
-    asBullet->OnCreate();
-}
-
 void MainState::DestroyBullet(Bullet* pBullet) noexcept {
     if(pBullet && pBullet->IsDead()) {
-        if(auto iter = std::find(std::begin(bullets), std::end(bullets), pBullet); iter != std::end(bullets)) {
-            *iter = nullptr;
-        }
-    }
-}
-
-void MainState::MakeMine(const GameEntity* parent, Vector2 position) noexcept {
-    if (auto* game = GetGameAs<Game>(); game) {
-        game->SetMineSpriteSheet();
+        bullets.Remove(pBullet->GetHandle());
     }
-
-    auto newMine = std::make_unique<Mine>(m_Scene, parent, position);
-    auto* last_entity = newMine.get();
-    m_pending_entities.emplace_back(std::move(newMine));
-    auto* asMine = reinterpret_cast<Mine*>(last_entity);
-    mines.push_back(asMine);
-    asMine->OnCreate();
 }
 
 void MainState::DestroyMine(Mine* pMine) noexcept {
     if(pMine && pMine->IsDead()) {
-        if(auto iter = std::find(std::begin(mines), std::end(mines), pMine); iter != std::end(mines)) {
-            *iter = nullptr;
-        }
-    }
-}
-
-void MainState::MakeSmallUfo(AABB2 world_bounds) noexcept {
-    if (auto* game = GetGameAs<Game>(); game) {
-        game->SetUfoSpriteSheets();
-    }
-    MakeUfo(Ufo::Type::Small, world_bounds);
-}
-
-void MainState::MakeBigUfo(AABB2 world_bounds) noexcept {
-    if (auto* game = GetGameAs<Game>(); game) {
-        game->SetUfoSpriteSheets();
-    }
-    MakeUfo(Ufo::Type::Big, world_bounds);
-}
-
-void MainState::MakeBossUfo(AABB2 world_bounds) noexcept {
-    if (auto* game = GetGameAs<Game>(); game) {
-        game->SetUfoSpriteSheets();
+        mines.Remove(pMine->GetHandle());
     }
-    MakeUfo(Ufo::Type::Boss, world_bounds);
-}
-
-void MainState::AddNewUfoToWorld(std::unique_ptr<Ufo> newUfo) noexcept {
-    auto* last_entity = newUfo.get();
-    m_pending_entities.emplace_back(std::move(newUfo));
-    auto* asUfo = reinterpret_cast<Ufo*>(last_entity);
-    ufos.push_back(asUfo);
-    asUfo->OnCreate();
 }
 
 void MainState::MakeUfo() noexcept {
@@ -615,21 +757,23 @@ void MainState::MakeUfo() noexcept {
 void MainState::MakeUfo(Ufo::Type type) noexcept {
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
         switch(type) {
-        case Ufo::Type::Small: MakeSmallUfo(m_world_bounds); break;
-        case Ufo::Type::Big: MakeBigUfo(m_world_bounds); break;
-        case Ufo::Type::Boss: MakeBossUfo(m_world_bounds); break;
+        case Ufo::Type::Small:
+        case Ufo::Type::Big:
+        case Ufo::Type::Boss:
+            MakeUfo(type, m_world_bounds);
+            break;
         default: break;
         }
     }
 }
 
 void MainState::MakeUfo(Ufo::Type type, AABB2 world_bounds) noexcept {
-    const auto pos = [world_bounds, type]()->const Vector2 {
+    const auto pos = [this, world_bounds, type]()->const Vector2 {
         const auto world_dims = world_bounds.CalcDimensions();
         const auto world_height = world_dims.y;
         const auto cr = Ufo::GetCosmeticRadiusFromType(type);
-        const auto y = [world_height, cr]() {
-            const auto r = MathUtils::GetRandomNegOneToOne<float>();
+        const auto y = [this, world_height, cr]() {
+            const auto r = m_spawn_rng.GetNegOneToOne<float>();
             if(r < 0.0f) {
                 return r * world_height + cr;
             }
@@ -638,19 +782,14 @@ void MainState::MakeUfo(Ufo::Type type, AABB2 world_bounds) noexcept {
 
         const auto left = Vector2{world_bounds.mins.x, y};
         const auto right = Vector2{world_bounds.maxs.x, y};
-        return MathUtils::GetRandomBool() ? left : right;
+        return m_spawn_rng.GetBool() ? left : right;
     }();
-    auto newUfo = std::make_unique<Ufo>(m_Scene, type, pos);
-    const auto ptr = newUfo.get();
-    AddNewUfoToWorld(std::move(newUfo));
-    ptr->SetVelocity(Vector2{pos.x < 0.0f ? -ptr->GetSpeed() : ptr->GetSpeed(), 0.0f});
+    RequestSpawn(SpawnRequest::ForUfo(static_cast<uint8_t>(type), pos));
 }
 
 void MainState::DestroyUfo(Ufo* pUfo) noexcept {
     if(pUfo && pUfo->IsDead()) {
-        if(auto iter = std::find(std::begin(ufos), std::end(ufos), pUfo); iter != std::end(ufos)) {
-            *iter = nullptr;
-        }
+        ufos.Remove(pUfo->GetHandle());
     }
 }
 
@@ -665,6 +804,8 @@ void MainState::MakeShip() noexcept {
             }
             ship = reinterpret_cast<Ship*>(m_entities.begin()->get());
             ship->OnCreate();
+            //The ship goes straight into the world rather than through the spawn queue.
+            GameEntity::GetKinematicsStore().CommitPending();
         }
     }
 }
@@ -679,36 +820,132 @@ void MainState::Respawn() noexcept {
     MakeShip();
 }
 
-void MainState::HandleBulletCollision() const noexcept {
-    HandleBulletAsteroidCollision();
-    HandleBulletUfoCollision();
+void MainState::RequestSpawn(const SpawnRequest& request) noexcept {
+    if(auto* game = GetGameAs<Game>(); game != nullptr) {
+        game->GetSpawnQueue().Push(request);
+    }
 }
 
-void MainState::HandleBulletAsteroidCollision() const noexcept {
-    for(auto& bullet : bullets) {
-        Disc2 bulletCollisionMesh{bullet->GetPosition(), bullet->GetPhysicalRadius()};
-        for(auto& asteroid : asteroids) {
-            Disc2 asteroidCollisionMesh{asteroid->GetPosition(), asteroid->GetPhysicalRadius()};
-            if(MathUtils::DoDiscsOverlap(bulletCollisionMesh, asteroidCollisionMesh)) {
-                asteroid->OnCollision(asteroid, bullet);
-            }
-        }
+void MainState::CommitSpawns() noexcept {
+    auto* game = GetGameAs<Game>();
+    if(game == nullptr) {
+        return;
+    }
+    auto& queue = game->GetSpawnQueue();
+    const auto& requests = queue.Collect();
+    if(requests.empty()) {
+        return;
+    }
+    const auto& counts = queue.GetCollectedCounts();
+    const auto count_of = [&counts](SpawnRequest::Type type) {
+        return counts[static_cast<std::size_t>(type)];
+    };
+    //Sprite sheets are looked up once per type present instead of once per spawn.
+    m_entities.reserve(m_entities.size() + requests.size());
+    if(const auto count = count_of(SpawnRequest::Type::Asteroid); count != 0u) {
+        asteroids.Reserve(asteroids.size() + count);
+        game->SetAsteroidSpriteSheet();
+    }
+    if(const auto count = count_of(SpawnRequest::Type::Bullet); count != 0u) {
+        bullets.Reserve(bullets.size() + count);
+    }
+    if(const auto count = count_of(SpawnRequest::Type::Explosion); count != 0u) {
+        explosions.Reserve(explosions.size() + count);
+        game->SetExplosionSpriteSheet();
+    }
+    if(const auto count = count_of(SpawnRequest::Type::Mine); count != 0u) {
+        mines.Reserve(mines.size() + count);
+        game->SetMineSpriteSheet();
+    }
+    if(const auto count = count_of(SpawnRequest::Type::Ufo); count != 0u) {
+        ufos.Reserve(ufos.size() + count);
+        game->SetUfoSpriteSheets();
+    }
+    for(const auto& request : requests) {
+        Spawn(request);
     }
 }
 
-void MainState::HandleBulletUfoCollision() const noexcept {
-    for(auto& ufo : ufos) {
-        Disc2 ufoCollisionMesh{ufo->GetPosition(), ufo->GetPhysicalRadius()};
-        for(auto& bullet : bullets) {
-            if(bullet->faction == ufo->faction) {
-                continue;
-            }
-            Disc2 bulletCollisionMesh{bullet->GetPosition(), bullet->GetPhysicalRadius()};
-            if(MathUtils::DoDiscsOverlap(bulletCollisionMesh, ufoCollisionMesh)) {
-                ufo->OnCollision(ufo, bullet);
-            }
+template<typename T>
+T* MainState::AddToWorld(TypedEntityList<T>& list, std::unique_ptr<T> entity) noexcept {
+    auto* added = entity.get();
+    m_entities.emplace_back(std::move(entity));
+    list.Add(added, added->GetHandle());
+    added->OnCreate();
+    return added;
+}
+
+void MainState::Spawn(const SpawnRequest& request) noexcept {
+    switch(request.type) {
+    case SpawnRequest::Type::Asteroid:
+        AddToWorld(asteroids, std::make_unique<Asteroid>(m_Scene, static_cast<Asteroid::Type>(request.variant), request.position, request.velocity, request.rotationSpeed));
+        break;
+    case SpawnRequest::Type::Bullet:
+        AddToWorld(bullets, std::make_unique<Bullet>(m_Scene, request.parent, request.position, request.velocity));
+        break;
+    case SpawnRequest::Type::Explosion:
+        AddToWorld(explosions, std::make_unique<Explosion>(m_Scene, request.position));
+        break;
+    case SpawnRequest::Type::Mine:
+        AddToWorld(mines, std::make_unique<Mine>(m_Scene, request.parent, request.position));
+        break;
+    case SpawnRequest::Type::Ufo:
+    {
+        auto* ufo = AddToWorld(ufos, std::make_unique<Ufo>(m_Scene, static_cast<Ufo::Type>(request.variant), request.position));
+        ufo->SetVelocity(Vector2{request.position.x < 0.0f ? -ufo->GetSpeed() : ufo->GetSpeed(), 0.0f});
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void MainState::HandleBulletCollision() const noexcept {
+    //Both passes split bullets the same way; the UFO pass gets the second half of the contact lists.
+    const auto chunks = JobSystem::CalcChunkCount(m_bullet_indices.size(), narrowphase_grain_size);
+    m_contacts.Begin(2u * chunks);
+    DetectContacts(asteroids, m_asteroid_hash, m_asteroid_indices, bullets, m_bullet_indices, 0u);
+    DetectContacts(ufos, m_ufo_hash, m_ufo_indices, bullets, m_bullet_indices, chunks);
+    ApplyContacts();
+}
+
+template<typename Target, typename Query>
+void MainState::DetectContacts(const TypedEntityList<Target>& targets, const SpatialHash& targetHash, const std::vector<KinematicsStore::index_type>& targetIndices, const TypedEntityList<Query>& queries, const std::vector<KinematicsStore::index_type>& queryIndices, std::size_t firstChunk) const noexcept {
+    auto* game = GetGameAs<Game>();
+    if(game == nullptr) {
+        return;
+    }
+    //Read-only: every job only looks at positions and writes to its own contact list.
+    game->GetJobSystem().ParallelFor(queryIndices.size(), narrowphase_grain_size, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        const auto& store = GameEntity::GetKinematicsStore();
+        const auto contact_chunk = firstChunk + chunk;
+        std::size_t pair_tests = 0u;
+        for(auto q = begin; q != end; ++q) {
+            auto* query = queries[q];
+            const auto qi = queryIndices[q];
+            const auto queryCollisionMesh = Disc2{store.GetPosition(qi), store.physical_radius[qi]};
+            targetHash.ForEachCandidate(store.GetPosition(qi), store.physical_radius[qi], [&](std::size_t t) {
+                auto* target = targets[t];
+                if(!CollisionResponse::CanInteract(*target, *query)) {
+                    return;
+                }
+                ++pair_tests;
+                const auto ti = targetIndices[t];
+                const auto targetCollisionMesh = Disc2{store.GetPosition(ti), store.physical_radius[ti]};
+                if(MathUtils::DoDiscsOverlap(queryCollisionMesh, targetCollisionMesh)) {
+                    m_contacts.Add(contact_chunk, *target, *query);
+                }
+            });
         }
+        m_contacts.AddPairTests(contact_chunk, pair_tests);
+    });
+}
+
+void MainState::ApplyContacts() const noexcept {
+    for(const auto& contact : m_contacts.Merge()) {
+        CollisionResponse::Dispatch(*contact.a, *contact.b);
     }
+    m_collision_pair_tests += m_contacts.GetPairTestCount();
 }
 
 void MainState::HandleShipCollision() noexcept {
@@ -722,18 +959,24 @@ void MainState::HandleShipAsteroidCollision() noexcept {
     }
     Disc2 shipCollisionMesh{ship->GetPosition(), ship->GetPhysicalRadius()};
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        for(auto& asteroid : asteroids) {
-            Disc2 asteroidCollisionMesh{asteroid->GetPosition(), asteroid->GetPhysicalRadius()};
+        const auto& store = GameEntity::GetKinematicsStore();
+        m_asteroid_hash.ForEachCandidate(ship->GetPosition(), ship->GetPhysicalRadius(), [&](std::size_t a) {
+            if(!ship) {
+                return;
+            }
+            ++m_collision_pair_tests;
+            const auto ai = m_asteroid_indices[a];
+            const auto asteroidCollisionMesh = Disc2{store.GetPosition(ai), store.physical_radius[ai]};
             if(MathUtils::DoDiscsOverlap(shipCollisionMesh, asteroidCollisionMesh)) {
-                ship->OnCollision(ship, asteroid);
-                asteroid->OnCollision(asteroid, ship);
+                auto* asteroid = asteroids[a];
+                CollisionResponse::Dispatch(*ship, *asteroid);
+                CollisionResponse::Dispatch(*asteroid, *ship);
                 if(ship && ship->IsDead()) {
                     DoCameraShake();
                     ship = nullptr;
-                    break;
                 }
             }
-        }
+        });
     }
 }
 
@@ -743,51 +986,32 @@ void MainState::HandleShipBulletCollision() noexcept {
     }
     const auto shipCollisionMesh = Disc2{ship->GetPosition(), ship->GetPhysicalRadius()};
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        for(auto& bullet : bullets) {
-            const auto bulletCollisionMesh = Disc2{bullet->GetPosition(), bullet->GetPhysicalRadius()};
+        const auto& store = GameEntity::GetKinematicsStore();
+        m_bullet_hash.ForEachCandidate(ship->GetPosition(), ship->GetPhysicalRadius(), [&](std::size_t b) {
+            if(!ship || !CollisionResponse::CanInteract(*ship, *bullets[b])) {
+                return;
+            }
+            ++m_collision_pair_tests;
+            const auto bi = m_bullet_indices[b];
+            const auto bulletCollisionMesh = Disc2{store.GetPosition(bi), store.physical_radius[bi]};
             if(MathUtils::DoDiscsOverlap(shipCollisionMesh, bulletCollisionMesh)) {
-                ship->OnCollision(ship, bullet);
+                CollisionResponse::Dispatch(*ship, *bullets[b]);
                 if(ship && ship->IsDead()) {
                     DoCameraShake();
                     ship = nullptr;
-                    break;
                 }
             }
-        }
+        });
     }
 }
 
 void MainState::HandleMineCollision() noexcept {
-    HandleMineAsteroidCollision();
-    HandleMineUfoCollision();
-}
-
-void MainState::HandleMineAsteroidCollision() noexcept {
-    if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        for(const auto& mine : mines) {
-            const auto mineCollisionMesh = Disc2{mine->GetPosition(), mine->GetPhysicalRadius()};
-            for(const auto& asteroid : asteroids) {
-                const auto asteroidCollisionMesh = Disc2{asteroid->GetPosition(), asteroid->GetPhysicalRadius()};
-                if(MathUtils::DoDiscsOverlap(mineCollisionMesh, asteroidCollisionMesh)) {
-                    asteroid->OnCollision(asteroid, mine);
-                }
-            }
-        }
-    }
-}
-
-void MainState::HandleMineUfoCollision() noexcept {
-    if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        for(const auto& mine : mines) {
-            const auto mineCollisionMesh = Disc2{mine->GetPosition(), mine->GetPhysicalRadius()};
-            for(const auto& ufo : ufos) {
-                const auto ufoCollisionMesh = Disc2{ufo->GetPosition(), ufo->GetPhysicalRadius()};
-                if(MathUtils::DoDiscsOverlap(mineCollisionMesh, ufoCollisionMesh)) {
-                    ufo->OnCollision(ufo, mine);
-                }
-            }
-        }
-    }
+    //Both passes split mines the same way; the UFO pass gets the second half of the contact lists.
+    const auto chunks = JobSystem::CalcChunkCount(m_mine_indices.size(), narrowphase_grain_size);
+    m_contacts.Begin(2u * chunks);
+    DetectContacts(asteroids, m_asteroid_hash, m_asteroid_indices, mines, m_mine_indices, 0u);
+    DetectContacts(ufos, m_ufo_hash, m_ufo_indices, mines, m_mine_indices, chunks);
+    ApplyContacts();
 }
 
 void MainState::KillAll() noexcept {
@@ -854,51 +1078,117 @@ void MainState::RenderBackground() const noexcept {
     }
 }
 
-void MainState::RenderEntities() const noexcept {
-    if(auto* game = GetGameAs<Game>(); game != nullptr) {
+void MainState::RenderEntities(const RenderSnapshot& snapshot, IRenderBackend& backend) const noexcept {
+    for(const auto& quad : snapshot.quads) {
+        UnitQuad::Render(backend, quad.material, quad.transform, quad.alpha);
+    }
+    snapshot.sprites.Render(backend);
+}
+
+void MainState::CaptureRenderSnapshot(RenderSnapshot& snapshot, const AABB2& cullBounds) const noexcept {
+    auto* game = GetGameAs<Game>();
+    snapshot.sprites.SetAtlas(game ? &game->sprite_atlas : nullptr);
+    snapshot.sprites.Begin(GameEntity::GetMaterialRegistry());
+    std::size_t visible_count = 0u;
+    std::size_t culled_count = 0u;
+    for(const auto& entity : m_entities) {
+        if(!entity) {
+            continue;
+        }
+        if(!IsVisible(*entity, cullBounds)) {
+            ++culled_count;
+            continue;
+        }
+        ++visible_count;
+        entity->AppendToRenderSnapshot(snapshot);
+    }
+    if(m_debug_render) {
+        //Every entity, culled or not, as the overlay has always shown them.
         for(const auto& entity : m_entities) {
             if(entity) {
-                entity->Render();
+                snapshot.debugEntities.push_back(RenderSnapshot::DebugEntity{entity->CalcRenderPosition(), entity->CalcRenderOrientationDegrees(), entity->GetCosmeticRadius(), entity->GetPhysicalRadius(), entity->GetVelocity(), entity->GetAcceleration()});
             }
         }
     }
+    auto& hud = snapshot.hud;
+    if(game) {
+        hud.score = game->player.GetScore();
+        hud.lives = game->player.GetLives();
+        hud.paused = game->IsPaused();
+        hud.gameOver = game->IsGameOver();
+    }
+    hud.fadeOutAlpha = m_fadeOut_alpha;
+    if(m_debug_render) {
+        const auto pool_stats = EntityPoolBase::GetTotalStats();
+        hud.debugText = std::format("Seed: {}\nFrame: {}\nVisible: {} Culled: {}\nSprite draws: {} ({} sprites)\nPair tests: {}\nPooled: {}/{}\nPool heap fallbacks: {} ({} total)\nHeap allocations: {}", GameEntity::GetRunSeed(), snapshot.frame, visible_count, culled_count, snapshot.sprites.GetDrawCallCount(), snapshot.sprites.GetInstanceCount(), GetCollisionPairTestCount(), pool_stats.live, pool_stats.capacity, m_pool_heap_fallbacks_this_frame, m_pool_heap_fallbacks_total, AllocationCounter::is_enabled ? std::format("{} last frame", m_heap_allocations_last_frame) : std::string{"not counted"});
+    }
+}
+
+void MainState::SetCaptureRenderSnapshots(bool capture) noexcept {
+    m_capture_render_snapshots = capture;
 }
 
-void MainState::DebugRenderEntities() const noexcept {
+const RenderSnapshot* MainState::AcquireRenderSnapshot() const noexcept {
+    return m_render_snapshots.AcquireForDraw();
+}
+
+void MainState::DebugRenderEntities(const RenderSnapshot& snapshot) const noexcept {
     if(!m_debug_render) {
         return;
     }
-    g_theRenderer->SetModelMatrix();
+    using Category = DebugDrawBatch::Category;
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        for(const auto& e : m_entities) {
-            if(!e) {
+        m_debug_draw.Begin();
+        const auto draw_motion = m_debug_draw.IsEnabled(Category::Motion);
+        //From the snapshot, not the live entities, which are already a frame ahead when it is drawn.
+        for(const auto& entity : snapshot.debugEntities) {
+            const auto center = entity.position;
+            const auto cosmetic_radius = entity.cosmeticRadius;
+            m_debug_draw.AddCircle(Category::Radii, center, cosmetic_radius, Rgba::Green);
+            m_debug_draw.AddCircle(Category::Radii, center, entity.physicalRadius, Rgba::Red);
+            if(!draw_motion) {
                 continue;
             }
-            const auto* entity = e.get();
-            const auto center = entity->GetPosition();
-            const auto orientation = entity->GetOrientationDegrees();
-            const auto cosmetic_radius = entity->GetCosmeticRadius();
-            const auto physical_radius = entity->GetPhysicalRadius();
+            const auto orientation = entity.orientationDegrees;
             const auto facing_end = [=]()->Vector2 { auto end = Vector2::X_Axis; end.SetLengthAndHeadingDegrees(orientation, cosmetic_radius); return center + end; }();
-            const auto velocity_end = [=]()->Vector2 { auto end = entity->GetVelocity().GetNormalize(); end.SetLengthAndHeadingDegrees(end.CalcHeadingDegrees(), cosmetic_radius); return center + end; }();
-            const auto acceleration_end = [=]()->Vector2 { auto end = entity->GetAcceleration().GetNormalize(); end.SetLengthAndHeadingDegrees(end.CalcHeadingDegrees(), cosmetic_radius); return center + end; }();
-            g_theRenderer->SetMaterial("circles");
-            g_theRenderer->DrawCircle2D(center, cosmetic_radius, Rgba::Green);
-            g_theRenderer->DrawCircle2D(center, physical_radius, Rgba::Red);
-            g_theRenderer->SetMaterial("__2D");
-            g_theRenderer->DrawLine2D(center, facing_end, Rgba::Red);
-            g_theRenderer->DrawLine2D(center, velocity_end, Rgba::Green);
-            g_theRenderer->DrawLine2D(center, acceleration_end, Rgba::Orange);
+            const auto velocity_end = [=]()->Vector2 { auto end = entity.velocity.GetNormalize(); end.SetLengthAndHeadingDegrees(end.CalcHeadingDegrees(), cosmetic_radius); return center + end; }();
+            const auto acceleration_end = [=]()->Vector2 { auto end = entity.acceleration.GetNormalize(); end.SetLengthAndHeadingDegrees(end.CalcHeadingDegrees(), cosmetic_radius); return center + end; }();
+            m_debug_draw.AddLine(Category::Motion, center, facing_end, Rgba::Red);
+            m_debug_draw.AddLine(Category::Motion, center, velocity_end, Rgba::Green);
+            m_debug_draw.AddLine(Category::Motion, center, acceleration_end, Rgba::Orange);
+        }
+        m_debug_draw.AddCircle(Category::Camera, m_cameraController.GetCamera().GetPosition(), 25.0f, Rgba::Pink);
+        m_debug_draw.AddAABB2(Category::Camera, CalculateCameraBounds(), Rgba::Periwinkle);
+        m_debug_draw.AddAABB2(Category::Bounds, m_world_bounds, Rgba::Green);
+        m_debug_draw.AddAABB2(Category::Bounds, game->CalcOrthoBounds(m_cameraController), Rgba::White);
+        m_debug_draw.AddAABB2(Category::Bounds, game->CalcViewBounds(m_cameraController), Rgba::Red);
+        m_debug_draw.AddAABB2(Category::Bounds, game->CalcCullBounds(m_cameraController), Rgba::White);
+        m_debug_draw.End(GameEntity::GetMaterialRegistry().GetMaterial(game->materials.flat2D));
+        g_theRenderer->SetModelMatrix();
+        m_debug_draw.Render();
+    }
+}
+
+bool MainState::IsVisible(const GameEntity& entity, const AABB2& cullBounds) const noexcept {
+    const auto center = entity.CalcRenderPosition();
+    const auto radius = entity.GetCosmeticRadius();
+    if(DoesDiscOverlapBounds(center, radius, cullBounds)) {
+        return true;
+    }
+    //A view looking across a seam must not drop the image of an entity on the other side.
+    const auto period = m_world_bounds.CalcDimensions() + Vector2{2.0f * radius, 2.0f * radius};
+    for(int y = -1; y <= 1; ++y) {
+        for(int x = -1; x <= 1; ++x) {
+            if(x == 0 && y == 0) {
+                continue;
+            }
+            const auto ghost = center + Vector2{static_cast<float>(x) * period.x, static_cast<float>(y) * period.y};
+            if(DoesDiscOverlapBounds(ghost, radius, cullBounds)) {
+                return true;
+            }
         }
-        g_theRenderer->SetMaterial("circles");
-        g_theRenderer->DrawCircle2D(m_cameraController.GetCamera().GetPosition(), 25.0f, Rgba::Pink);
-        g_theRenderer->SetMaterial("__2D");
-        g_theRenderer->DrawAABB2(m_world_bounds, Rgba::Green, Rgba::NoAlpha);
-        g_theRenderer->DrawAABB2(game->CalcOrthoBounds(m_cameraController), Rgba::White, Rgba::NoAlpha);
-        g_theRenderer->DrawAABB2(game->CalcViewBounds(m_cameraController), Rgba::Red, Rgba::NoAlpha);
-        g_theRenderer->DrawAABB2(game->CalcCullBounds(m_cameraController), Rgba::White, Rgba::NoAlpha);
-        g_theRenderer->DrawAABB2(CalculateCameraBounds(), Rgba::Periwinkle, Rgba::NoAlpha);
     }
+    return false;
 }
 
 AABB2 MainState::CalculateCameraBounds() const noexcept {
@@ -917,7 +1207,7 @@ AABB2 MainState::CalculateCameraBounds() const noexcept {
     return result;
 }
 
-void MainState::RenderStatus() const noexcept {
+void MainState::RenderStatus(const RenderSnapshot& snapshot) const noexcept {
     static Camera2D ui_camera = m_cameraController.GetCamera();
     const float ui_view_height = ui_camera.GetViewHeight();
     const float ui_view_width = ui_view_height * ui_camera.GetAspectRatio();
@@ -932,33 +1222,13 @@ void MainState::RenderStatus() const noexcept {
     ui_camera.SetupView(ui_leftBottom, ui_rightTop, ui_nearFar, MathUtils::M_16_BY_9_RATIO);
     g_theRenderer->SetCamera(ui_camera);
 
-    const auto* font = g_theRenderer->GetFont("System32");
-    const auto font_position = ui_cam_pos - ui_view_half_extents + Vector2{5.0f, font->GetLineHeight() * 0.0f};
-
-    g_theRenderer->SetModelMatrix();
-    g_theRenderer->SetModelMatrix(Matrix4::CreateTranslationMatrix(font_position));
-    const auto [playerScore, playerLives] = []() {
-        if(auto* game = GetGameAs<Game>(); game != nullptr) {
-            return std::pair<const long long, const long long>(game->player.GetScore(), game->player.GetLives());
-        }
-        return std::pair<const long long, const long long>(0LL, 0LL);
-    }(); //IIIL
-    g_theRenderer->DrawMultilineText(g_theRenderer->GetFont("System32"), std::format("Score: {}\n{:>6}{}", playerScore, 'x', playerLives));
-
-    const auto uvs = AABB2::Zero_to_One;
-    const auto mat = g_theRenderer->GetMaterial("ship");
-    const auto tex = mat->GetTexture(Material::TextureID::Diffuse);
-    const auto frameWidth = static_cast<float>(tex->GetDimensions().x);
-    const auto frameHeight = static_cast<float>(tex->GetDimensions().y);
-    const auto half_extents = Vector2{frameWidth, frameHeight};
-    const auto S = Matrix4::CreateScaleMatrix(half_extents);
-    const auto R = Matrix4::I;
-    const auto T = Matrix4::CreateTranslationMatrix(font_position + Vector2{15.0f + font->CalculateTextWidth(" "), font->GetLineHeight() * 1.8f});
-    const auto transform = Matrix4::MakeSRT(S, R, T);
+    const auto font_position = ui_cam_pos - ui_view_half_extents + Vector2{5.0f, 0.0f};
+    m_hud.Render(font_position, snapshot.hud.score, snapshot.hud.lives);
 
-    g_theRenderer->SetModelMatrix(transform);
-    g_theRenderer->SetMaterial(mat);
-    g_theRenderer->DrawQuad2D();
+    if(auto* font = m_hud.GetFont(); font != nullptr && !snapshot.hud.debugText.empty()) {
+        g_theRenderer->SetModelMatrix(Matrix4::CreateTranslationMatrix(font_position + Vector2{0.0f, font->GetLineHeight() * 3.0f}));
+        g_theRenderer->DrawMultilineText(font, snapshot.hud.debugText);
+    }
 }
 
 void MainState::DoCameraShake() noexcept {
@@ -974,34 +1244,40 @@ bool MainState::DoFadeOut(TimeUtils::FPSeconds deltaSeconds) noexcept {
     return alpha == 1.0f;
 }
 
-void MainState::PostFrameCleanup() noexcept {
-    for(auto& e : explosions) {
-        DestroyExplosion(e);
+void MainState::DestroyEntity(GameEntity* pEntity) noexcept {
+    switch(pEntity->kind) {
+    case GameEntity::Kind::Asteroid: DestroyAsteroid(static_cast<Asteroid*>(pEntity)); break;
+    case GameEntity::Kind::Bullet: DestroyBullet(static_cast<Bullet*>(pEntity)); break;
+    case GameEntity::Kind::Explosion: DestroyExplosion(static_cast<Explosion*>(pEntity)); break;
+    case GameEntity::Kind::Mine: DestroyMine(static_cast<Mine*>(pEntity)); break;
+    case GameEntity::Kind::Ufo: DestroyUfo(static_cast<Ufo*>(pEntity)); break;
+    default: break;
     }
-    for(auto& e : bullets) {
-        DestroyBullet(e);
-    }
-    for(auto& e : asteroids) {
-        DestroyAsteroid(e);
-    }
-    for(auto& e : ufos) {
-        DestroyUfo(e);
+}
+
+void MainState::PostFrameCleanup() noexcept {
+    ScopedPhaseTimer timer{m_phase_times, FramePhase::Cleanup};
+    for(auto& entity : m_entities) {
+        if(entity && entity->IsDead()) {
+            DestroyEntity(entity.get());
+            entity->OnDestroy();
+        }
     }
-    for(auto& e : mines) {
-        DestroyMine(e);
+    //Committed before the dead are freed: a bullet fired this tick may belong
+    //to one of them, and the explosions their OnDestroy asked for go in too.
+    CommitSpawns();
+    GameEntity::GetKinematicsStore().CommitPending();
+    for(auto& entity : m_entities) {
+        if(entity && entity->IsDead()) {
+            entity.reset();
+        }
     }
-
-    explosions.erase(std::remove_if(std::begin(explosions), std::end(explosions), [&](Explosion* e) { return !e; }), std::end(explosions));
-    bullets.erase(std::remove_if(std::begin(bullets), std::end(bullets), [&](Bullet* e) { return !e; }), std::end(bullets));
-    asteroids.erase(std::remove_if(std::begin(asteroids), std::end(asteroids), [&](Asteroid* e) { return !e; }), std::end(asteroids));
-    ufos.erase(std::remove_if(std::begin(ufos), std::end(ufos), [&](Ufo* e) { return !e; }), std::end(ufos));
-    mines.erase(std::remove_if(std::begin(mines), std::end(mines), [&](Mine* e) { return !e; }), std::end(mines));
     m_entities.erase(std::remove_if(std::begin(m_entities) + 1, std::end(m_entities), [&](std::unique_ptr<GameEntity>& e) { return !e; }), std::end(m_entities));
 
-    for(auto&& pending : m_pending_entities) {
-        m_entities.emplace_back(std::move(pending));
-    }
-    m_pending_entities.clear();
+    const auto heap_fallbacks = EntityPoolBase::GetTotalStats().heap_fallbacks;
+    m_pool_heap_fallbacks_this_frame = heap_fallbacks - m_pool_heap_fallbacks_total;
+    m_pool_heap_fallbacks_total = heap_fallbacks;
+    EntityPoolBase::RecycleAll();
 }
 
 bool MainState::IsWaveComplete() const noexcept {
@@ -1024,9 +1300,9 @@ Asteroid* MainState::GetClosestAsteroidToPlayer() const noexcept {
     return GetClosestAsteroidToEntity(GetShip());
 }
 
-void MainState::RenderPausedOverlay() const noexcept {
+void MainState::RenderPausedOverlay(const RenderSnapshot& snapshot) const noexcept {
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        if(!game->IsPaused()) {
+        if(!snapshot.hud.paused) {
             return;
         }
         const auto ui_view_height = static_cast<float>(game->gameOptions.GetWindowHeight());
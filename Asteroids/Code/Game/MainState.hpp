@@ -13,14 +13,27 @@
 #include "Game/GameCommon.hpp"
 
 #include "Game/Game.hpp"
+#include "Game/AllocationCounter.hpp"
+#include "Game/ContactSet.hpp"
+#include "Game/DebugDrawBatch.hpp"
+#include "Game/DeviceRenderBackend.hpp"
+#include "Game/EntityHandle.hpp"
+#include "Game/KinematicsStore.hpp"
 #include "Game/GameState.hpp"
+#include "Game/HudLayer.hpp"
+#include "Game/InputLog.hpp"
 #include "Game/Player.hpp"
+#include "Game/SpatialHash.hpp"
+#include "Game/RenderSnapshot.hpp"
+#include "Game/SpawnQueue.hpp"
 #include "Game/Ufo.hpp"
 
+#include <array>
 #include <memory>
 #include <vector>
 
 class Asteroid;
+class BenchmarkRunner;
 class Bullet;
 class Explosion;
 class Ship;
@@ -30,6 +43,18 @@ class Mine;
 
 class MainState : public GameState {
 public:
+    enum class FramePhase : uint8_t {
+        Update
+        , Broadphase
+        , BulletCollision
+        , ShipCollision
+        , MineCollision
+        , Cleanup
+        , RenderBuild
+        , Max
+    };
+    using FramePhaseTimes = std::array<TimeUtils::FPSeconds, static_cast<std::size_t>(FramePhase::Max)>;
+
     virtual ~MainState() = default;
 
     void OnEnter() noexcept override;
@@ -40,15 +65,28 @@ public:
     void EndFrame() noexcept override;
 
     mutable Ship* ship{nullptr};
-    
-    void MakeExplosion(Vector2 position) noexcept;
-    void MakeMediumAsteroid(Vector2 pos, Vector2 vel, float rotationSpeed) noexcept;
-    void MakeSmallAsteroid(Vector2 pos, Vector2 vel, float rotationSpeed) noexcept;
-    void MakeBullet(const GameEntity* parent, Vector2 pos, Vector2 vel) noexcept;
-    void MakeMine(const GameEntity* parent, Vector2 position) noexcept;
+
+    std::size_t GetCollisionPairTestCount() const noexcept;
+    //Time spent in each phase since the last BeginFrame, summed over every simulation tick.
+    const FramePhaseTimes& GetFramePhaseTimes() const noexcept;
+
+    //Appends what the player did every frame to log; null stops recording.
+    void SetInputRecording(InputLog* log) noexcept;
+    //Takes the player's input from log instead of the devices or the autopilot; null stops playback.
+    void SetInputPlayback(InputLog* log) noexcept;
+    //Hash of the simulation state; equal for runs that went exactly the same way.
+    [[nodiscard]] uint64_t CalcStateHash() const noexcept;
+
+    //Windowed runs always capture; headless runs only when asked to, e.g. to verify snapshots.
+    void SetCaptureRenderSnapshots(bool capture) noexcept;
+    //The snapshot Render would draw now, once it is prepared.
+    const RenderSnapshot* AcquireRenderSnapshot() const noexcept;
 
 protected:
 private:
+    friend class BenchmarkRunner;
+    friend class HeadlessRunner;
+
     std::unique_ptr<GameState> HandleInput([[maybe_unused]] TimeUtils::FPSeconds deltaSeconds) noexcept override;
     std::unique_ptr<GameState> HandleKeyboardInput([[maybe_unused]] TimeUtils::FPSeconds deltaSeconds) noexcept;
     std::unique_ptr<GameState> HandleControllerInput([[maybe_unused]] TimeUtils::FPSeconds deltaSeconds) noexcept;
@@ -58,32 +96,29 @@ private:
     void HandleDebugKeyboardInput([[maybe_unused]] TimeUtils::FPSeconds deltaSeconds);
 
     void FireAtPlayer(TimeUtils::FPSeconds deltaSeconds, GameEntity* entity, bool leadTarget) const noexcept;
-    void FireAtClosestAsteroid(TimeUtils::FPSeconds deltaSeconds, GameEntity* entity) const noexcept;
+    void FireAtClosestAsteroid(TimeUtils::FPSeconds deltaSeconds, Ship* entity) const noexcept;
     void FireAtClosestAsteroidToPlayer(TimeUtils::FPSeconds deltaSeconds) const noexcept;
 
     void HandlePlayerInput([[maybe_unused]] TimeUtils::FPSeconds deltaSeconds);
+    void ReplayPlayerInput() noexcept;
     void ClampCameraToWorld() noexcept;
 
-    void WrapAroundWorld(GameEntity* e) noexcept;
+    void WrapAroundWorld(KinematicsStore::index_type index) noexcept;
+    void GatherKinematicsIndices() noexcept;
+    void RebuildBroadphase() noexcept;
     void UpdateEntities(TimeUtils::FPSeconds deltaSeconds) noexcept;
+    void TickSimulation(TimeUtils::FPSeconds step) noexcept;
     void StartNewWave(unsigned int wave_number) noexcept;
 
     void MakeLargeAsteroidOffScreen(AABB2 world_bounds) noexcept;
     void MakeLargeAsteroidAt(Vector2 pos) noexcept;
     void MakeLargeAsteroid(Vector2 pos, Vector2 vel, float rotationSpeed) noexcept;
 
-    void AddNewAsteroidToWorld(std::unique_ptr<Asteroid> newAsteroid);
     Asteroid* GetClosestAsteroidToEntity(GameEntity* entity) const noexcept;
     Asteroid* GetClosestAsteroidToPlayer() const noexcept;
 
     Ship* GetShip() const noexcept;
 
-    void MakeSmallUfo(AABB2 world_bounds) noexcept;
-    void MakeBigUfo(AABB2 world_bounds) noexcept;
-    void MakeBossUfo(AABB2 world_bounds) noexcept;
-
-    void AddNewUfoToWorld(std::unique_ptr<Ufo> newUfo) noexcept;
-
     void MakeUfo() noexcept;
     void MakeUfo(Ufo::Type type) noexcept;
 
@@ -94,35 +129,48 @@ private:
 
     void Respawn() noexcept;
 
+    void RequestSpawn(const SpawnRequest& request) noexcept;
+    //Creates everything requested since the last commit, reserving each list once.
+    void CommitSpawns() noexcept;
+    void Spawn(const SpawnRequest& request) noexcept;
+    template<typename T>
+    T* AddToWorld(TypedEntityList<T>& list, std::unique_ptr<T> entity) noexcept;
+
     void DestroyAsteroid(Asteroid* pAsteroid) noexcept;
     void DestroyBullet(Bullet* pBullet) noexcept;
     void DestroyExplosion(Explosion* pExplosion) noexcept;
     void DestroyMine(Mine* pMine) noexcept;
     void DestroyUfo(Ufo* pUfo) noexcept;
+    void DestroyEntity(GameEntity* pEntity) noexcept;
 
+    //Bullets and mines are tested against asteroids and UFOs in two passes:
+    //a parallel detect into m_contacts, then the responses in spawn id order.
     void HandleBulletCollision() const noexcept;
-    void HandleBulletAsteroidCollision() const noexcept;
-    void HandleBulletUfoCollision() const noexcept;
+    template<typename Target, typename Query>
+    void DetectContacts(const TypedEntityList<Target>& targets, const SpatialHash& targetHash, const std::vector<KinematicsStore::index_type>& targetIndices, const TypedEntityList<Query>& queries, const std::vector<KinematicsStore::index_type>& queryIndices, std::size_t firstChunk) const noexcept;
+    void ApplyContacts() const noexcept;
     void HandleShipCollision() noexcept;
     void HandleShipAsteroidCollision() noexcept;
     void HandleShipBulletCollision() noexcept;
     void HandleMineCollision() noexcept;
-    void HandleMineUfoCollision() noexcept;
-    void HandleMineAsteroidCollision() noexcept;
     void KillAll() noexcept;
 
     unsigned int GetWaveMultiplierFromDifficulty() const noexcept;
     long long GetLivesFromDifficulty() const noexcept;
 
     void RenderBackground() const noexcept;
-    void RenderEntities() const noexcept;
-    void DebugRenderEntities() const noexcept;
-    void RenderFadeOutOverlay() const noexcept;
-    void RenderPausedOverlay() const noexcept;
+    //Culls the entities and copies what is left, plus the HUD, into snapshot.
+    void CaptureRenderSnapshot(RenderSnapshot& snapshot, const AABB2& cullBounds) const noexcept;
+    //Draws the snapshot's quads and sprites; the engine-owned particle effects are drawn separately.
+    void RenderEntities(const RenderSnapshot& snapshot, IRenderBackend& backend) const noexcept;
+    void DebugRenderEntities(const RenderSnapshot& snapshot) const noexcept;
+    void RenderFadeOutOverlay(const RenderSnapshot& snapshot) const noexcept;
+    void RenderPausedOverlay(const RenderSnapshot& snapshot) const noexcept;
 
     AABB2 CalculateCameraBounds() const noexcept;
+    bool IsVisible(const GameEntity& entity, const AABB2& cullBounds) const noexcept;
 
-    void RenderStatus() const noexcept;
+    void RenderStatus(const RenderSnapshot& snapshot) const noexcept;
 
     void DoCameraShake() noexcept;
     bool DoFadeOut(TimeUtils::FPSeconds deltaSeconds) noexcept;
@@ -133,13 +181,47 @@ private:
 
     std::shared_ptr<Scene> m_Scene{};
     unsigned int m_current_wave{1u};
-    std::vector<Asteroid*> asteroids{};
-    std::vector<Ufo*> ufos{};
-    std::vector<Bullet*> bullets{};
-    std::vector<Explosion*> explosions{};
-    std::vector<Mine*> mines{};
+    TypedEntityList<Asteroid> asteroids{};
+    TypedEntityList<Ufo> ufos{};
+    TypedEntityList<Bullet> bullets{};
+    TypedEntityList<Explosion> explosions{};
+    TypedEntityList<Mine> mines{};
     std::vector<std::unique_ptr<GameEntity>> m_entities{};
-    std::vector<std::unique_ptr<GameEntity>> m_pending_entities{};
+    std::vector<KinematicsStore::index_type> m_asteroid_indices{};
+    std::vector<KinematicsStore::index_type> m_bullet_indices{};
+    std::vector<KinematicsStore::index_type> m_ufo_indices{};
+    std::vector<KinematicsStore::index_type> m_mine_indices{};
+    SpatialHash m_asteroid_hash{};
+    SpatialHash m_bullet_hash{};
+    SpatialHash m_ufo_hash{};
+    mutable std::size_t m_collision_pair_tests{0u};
+    mutable FramePhaseTimes m_phase_times{};
+    mutable RenderSnapshotBuffer m_render_snapshots{false};
+    bool m_capture_render_snapshots{true};
+    mutable DeviceRenderBackend m_device_backend{};
+    mutable HudLayer m_hud{};
+    mutable DebugDrawBatch m_debug_draw{};
+    std::size_t m_pool_heap_fallbacks_this_frame{0u};
+    std::size_t m_pool_heap_fallbacks_total{0u};
+    //Every heap allocation from one BeginFrame to the next, not just pool fallbacks.
+    AllocationCounter::Totals m_allocations_at_frame_begin{};
+    uint64_t m_heap_allocations_last_frame{0u};
+
+    //Small enough to spread a big wave over every core, large enough that a
+    //chunk outweighs the cost of queueing it.
+    static inline constexpr const std::size_t update_grain_size = 256u;
+    static inline constexpr const std::size_t wrap_grain_size = 4096u;
+    static inline constexpr const std::size_t transform_grain_size = 2048u;
+    static inline constexpr const std::size_t narrowphase_grain_size = 128u;
+    mutable ContactSet m_contacts{};
+
+    //Bounds the catch-up work per frame so a slow frame cannot snowball into slower ones.
+    static inline constexpr const int max_sim_steps_per_frame = 5;
+    TimeUtils::FPSeconds m_sim_step{1.0f / 60.0f};
+    TimeUtils::FPSeconds m_sim_accumulator{0.0f};
+    RandomStream m_spawn_rng{};
+    InputLog* m_input_recording{nullptr};
+    InputLog* m_input_playback{nullptr};
 
     OrthographicCameraController m_cameraController{};
     float m_thrust_force{100.0f};
@@ -0,0 +1,56 @@
+#include "Game/MaterialRegistry.hpp"
+
+#include "Engine/Renderer/Material.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+
+#include "Engine/Services/ServiceLocator.hpp"
+#include "Engine/Services/IRendererService.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+MaterialHandle MaterialRegistry::Register(std::string_view name) noexcept {
+    const auto found = std::find_if(std::cbegin(m_entries), std::cend(m_entries), [name](const Entry& entry) { return entry.name == name; });
+    if(found != std::cend(m_entries)) {
+        return MaterialHandle{static_cast<uint32_t>(std::distance(std::cbegin(m_entries), found))};
+    }
+    if(m_locked) {
+        return MaterialHandle{};
+    }
+    auto& entry = m_entries.emplace_back(Entry{std::string{name}});
+    Resolve(entry);
+    return MaterialHandle{static_cast<uint32_t>(m_entries.size() - 1u)};
+}
+
+void MaterialRegistry::Lock() noexcept {
+    m_locked = true;
+}
+
+void MaterialRegistry::Refresh() noexcept {
+    for(auto& entry : m_entries) {
+        Resolve(entry);
+    }
+    ++m_epoch;
+}
+
+Material* MaterialRegistry::GetMaterial(MaterialHandle handle) const noexcept {
+    return handle.index < m_entries.size() ? m_entries[handle.index].material : nullptr;
+}
+
+Vector2 MaterialRegistry::GetDiffuseDimensions(MaterialHandle handle) const noexcept {
+    return handle.index < m_entries.size() ? m_entries[handle.index].diffuseDimensions : Vector2{};
+}
+
+uint32_t MaterialRegistry::GetEpoch() const noexcept {
+    return m_epoch;
+}
+
+void MaterialRegistry::Resolve(Entry& entry) noexcept {
+    entry.material = ServiceLocator::get<IRendererService>()->GetMaterial(entry.name);
+    entry.diffuseDimensions = Vector2{};
+    if(entry.material != nullptr) {
+        if(const auto* tex = entry.material->GetTexture(Material::TextureID::Diffuse); tex != nullptr) {
+            entry.diffuseDimensions = Vector2{static_cast<float>(tex->GetDimensions().x), static_cast<float>(tex->GetDimensions().y)};
+        }
+    }
+}
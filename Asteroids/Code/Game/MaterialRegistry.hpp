@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Engine/Math/Vector2.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Material;
+
+//Stable index into the MaterialRegistry. Handles survive material reloads.
+struct MaterialHandle {
+    static inline constexpr const uint32_t invalid_index = (std::numeric_limits<uint32_t>::max)();
+
+    uint32_t index{invalid_index};
+
+    [[nodiscard]] constexpr bool IsValid() const noexcept {
+        return index != invalid_index;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const MaterialHandle& a, const MaterialHandle& b) noexcept = default;
+};
+
+//Resolves material names to handles once, so per-frame code does an index
+//instead of a string-keyed lookup. The diffuse texture size is cached with
+//each material. Refresh re-resolves every name after assets are reloaded and
+//bumps the epoch so anything caching resolved pointers knows to drop them.
+//Names are only added at startup: after Lock, Register just looks names up and
+//the entry list never grows, so other threads can resolve handles while
+//entities spawn.
+class MaterialRegistry {
+public:
+    MaterialRegistry() noexcept = default;
+    MaterialRegistry(const MaterialRegistry& other) = delete;
+    MaterialRegistry(MaterialRegistry&& other) = delete;
+    MaterialRegistry& operator=(const MaterialRegistry& other) = delete;
+    MaterialRegistry& operator=(MaterialRegistry&& other) = delete;
+    ~MaterialRegistry() noexcept = default;
+
+    //Returns the existing handle if the name is already registered, and an
+    //invalid handle for a new name once the registry is locked.
+    [[nodiscard]] MaterialHandle Register(std::string_view name) noexcept;
+    void Lock() noexcept;
+    void Refresh() noexcept;
+
+    //nullptr if the renderer has no such material, e.g. when running headless.
+    [[nodiscard]] Material* GetMaterial(MaterialHandle handle) const noexcept;
+    [[nodiscard]] Vector2 GetDiffuseDimensions(MaterialHandle handle) const noexcept;
+    [[nodiscard]] uint32_t GetEpoch() const noexcept;
+
+protected:
+private:
+    struct Entry {
+        std::string name{};
+        Material* material{nullptr};
+        Vector2 diffuseDimensions{};
+    };
+
+    static void Resolve(Entry& entry) noexcept;
+
+    std::vector<Entry> m_entries{};
+    uint32_t m_epoch{0u};
+    bool m_locked{false};
+};
@@ -8,67 +8,75 @@
 
 #include "Engine/Scene/Components.hpp"
 
+#include "Engine/Services/ServiceLocator.hpp"
+#include "Engine/Services/IRendererService.hpp"
+
+#include "Game/EntityPool.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/Game.hpp"
 #include "Game/Bullet.hpp"
 #include "Game/MainState.hpp"
 
+namespace {
+
+EntityPool<Mine, 64>& GetMinePool() noexcept {
+    static EntityPool<Mine, 64> pool{};
+    return pool;
+}
+
+}
+
+void* Mine::operator new(std::size_t size) {
+    return GetMinePool().Allocate(size);
+}
+
+void Mine::operator delete(void* ptr, std::size_t size) noexcept {
+    GetMinePool().Deallocate(ptr, size);
+}
+
 Mine::Mine(std::weak_ptr<Scene> scene, const GameEntity* parent, Vector2 position)
     : GameEntity(scene.lock()->CreateEntity(), scene, parent)
 {
     UpdateComponent<TransformComponent>(Matrix4::CreateTranslationMatrix(position));
 
     faction = HasGameParent() ? GetGameParent()->faction : GameEntity::Faction::None;
+    kind = GameEntity::Kind::Mine;
+    m_material = GetGameAs<Game>()->materials.mine;
     SetPosition(position);
     SetCosmeticRadius(25.0f);
     SetPhysicalRadius(25.0f);
 
+    auto* rs = ServiceLocator::get<IRendererService>();
     AnimatedSpriteDesc desc{};
-    desc.material = g_theRenderer->GetMaterial("mine");
+    desc.material = GetMaterial();
     desc.spriteSheet = GetSpriteSheet();
     desc.durationSeconds = TimeUtils::FPSeconds{1.0f};
     desc.playbackMode = AnimatedSprite::SpriteAnimMode::Looping;
     desc.frameLength = 12;
     desc.startSpriteIndex = 0;
 
-    _sprite = g_theRenderer->CreateAnimatedSprite(desc);
+    _sprite = rs->CreateAnimatedSprite(desc);
 
 }
 
 void Mine::Update(TimeUtils::FPSeconds deltaSeconds) noexcept {
     GameEntity::Update(deltaSeconds);
+    if(!_sprite) {
+        return;
+    }
+    RefreshSpriteMaterial(*_sprite);
     _sprite->Update(deltaSeconds);
 
-    const auto uvs = _sprite->GetCurrentTexCoords();
     const auto frameWidth = static_cast<float>(_sprite->GetFrameDimensions().x);
     const auto frameHeight = static_cast<float>(_sprite->GetFrameDimensions().y);
     const auto half_extents = Vector2{frameWidth, frameHeight};
-    {
-        const auto S = Matrix4::CreateScaleMatrix(half_extents);
-        const auto R = Matrix4::I;
-        const auto T = Matrix4::CreateTranslationMatrix(GetPosition());
-        UpdateComponent<TransformComponent>(Matrix4::MakeSRT(S, R, T));
-    }
-
-    auto& builder = m_mesh_builder;
-    builder.Begin(PrimitiveType::Triangles);
-    builder.SetColor(Rgba::White);
-
-    builder.SetUV(Vector2{uvs.maxs.x, uvs.maxs.y});
-    builder.AddVertex(Vector2{+0.5f, +0.5f});
-
-    builder.SetUV(Vector2{uvs.mins.x, uvs.maxs.y});
-    builder.AddVertex(Vector2{-0.5f, +0.5f});
-
-    builder.SetUV(Vector2{uvs.mins.x, uvs.mins.y});
-    builder.AddVertex(Vector2{-0.5f, -0.5f});
-
-    builder.SetUV(Vector2{uvs.maxs.x, uvs.mins.y});
-    builder.AddVertex(Vector2{+0.5f, -0.5f});
-
-    builder.AddIndicies(Mesh::Builder::Primitive::Quad);
-    builder.End(GetMaterial());
+    UpdateTransform(half_extents);
+}
 
+bool Mine::AppendToSpriteBatch(SpriteBatch& batch) const noexcept {
+    const auto uvs = _sprite ? _sprite->GetCurrentTexCoords() : AABB2::Zero_to_One;
+    batch.Add(m_material, MakeSpriteInstance(uvs));
+    return true;
 }
 
 void Mine::EndFrame() noexcept {
@@ -90,16 +98,10 @@ void Mine::OnFire() noexcept {
 void Mine::OnDestroy() noexcept {
     GameEntity::OnDestroy();
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        if (auto* const mainState = dynamic_cast<MainState* const>(game->GetCurrentState()); mainState != nullptr) {
-            mainState->MakeExplosion(GetPosition());
-        }
+        game->GetSpawnQueue().Push(SpawnRequest::ForExplosion(GetPosition()));
     }
 }
 
-Material* Mine::GetMaterial() const noexcept {
-    return g_theRenderer->GetMaterial("mine");
-}
-
 std::weak_ptr<SpriteSheet> Mine::GetSpriteSheet() const noexcept {
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
         return game->mine_sheet;
@@ -6,6 +6,7 @@
 
 #include "Game/GameEntity.hpp"
 
+#include <cstddef>
 #include <memory>
 
 class Mine : public GameEntity {
@@ -13,7 +14,11 @@ public:
     explicit Mine(std::weak_ptr<Scene> scene, const GameEntity* parent, Vector2 position);
     virtual ~Mine() = default;
 
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size) noexcept;
+
     void Update(TimeUtils::FPSeconds deltaSeconds) noexcept override;
+    bool AppendToSpriteBatch(SpriteBatch& batch) const noexcept override;
     void EndFrame() noexcept override;
 
     void OnCreate() noexcept override;
@@ -21,7 +26,6 @@ public:
     void OnFire() noexcept override;
     void OnDestroy() noexcept;
 
-    Material* GetMaterial() const noexcept override;
 protected:
 private:
     std::unique_ptr<class AnimatedSprite> _sprite{};
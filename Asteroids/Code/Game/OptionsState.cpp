@@ -210,9 +210,9 @@ void OptionsState::CycleSelectedOptionDown(OptionsMenu selectedItem) noexcept {
     {
         auto cur_soundVolume = m_temp_options.GetSoundVolume();
         m_temp_options.SetSoundVolume(std::clamp(cur_soundVolume ? --cur_soundVolume : cur_soundVolume, m_min_sound_volume, m_max_sound_volume));
-        AudioSystem::SoundDesc desc{};
-        desc.groupName = g_audiogroup_sound;
-        g_theAudioSystem->Play(g_sound_shootpath, desc);
+        if(auto* game = GetGameAs<Game>(); game != nullptr) {
+            game->GetAudio().Play(game->sounds.shoot);
+        }
         break;
     }
     case OptionsMenu::MusicVolume:
@@ -256,9 +256,9 @@ void OptionsState::CycleSelectedOptionUp(OptionsMenu selectedItem) noexcept {
     {
         auto cur_soundVolume = m_temp_options.GetSoundVolume();
         m_temp_options.SetSoundVolume((std::min)(++cur_soundVolume, m_max_sound_volume));
-        AudioSystem::SoundDesc desc{};
-        desc.groupName = g_audiogroup_sound;
-        g_theAudioSystem->Play(g_sound_shootpath, desc);
+        if(auto* game = GetGameAs<Game>(); game != nullptr) {
+            game->GetAudio().Play(game->sounds.shoot);
+        }
         break;
     }
     case OptionsMenu::MusicVolume:
@@ -0,0 +1,74 @@
+#include "Game/RandomStream.hpp"
+
+#include <cmath>
+
+namespace {
+
+//Spreads nearby seeds and stream ids across the whole state space.
+[[nodiscard]] uint64_t SplitMix64(uint64_t value) noexcept {
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+} // namespace
+
+RandomStream::RandomStream() noexcept
+: RandomStream(0u, 0u)
+{
+    /* DO NOTHING */
+}
+
+RandomStream::RandomStream(uint64_t seed, uint64_t stream) noexcept {
+    Seed(seed, stream);
+}
+
+RandomStream::RandomStream(uint64_t seed, Subsystem subsystem) noexcept
+: RandomStream(seed, static_cast<uint64_t>(subsystem))
+{
+    /* DO NOTHING */
+}
+
+void RandomStream::Seed(uint64_t seed, uint64_t stream) noexcept {
+    m_state = 0u;
+    m_increment = (SplitMix64(stream) << 1u) | 1u;
+    (void)Next();
+    m_state += SplitMix64(seed ^ stream);
+    (void)Next();
+}
+
+uint32_t RandomStream::Next() noexcept {
+    const auto old_state = m_state;
+    m_state = old_state * 6364136223846793005ull + m_increment;
+    const auto xorshifted = static_cast<uint32_t>(((old_state >> 18u) ^ old_state) >> 27u);
+    const auto rot = static_cast<uint32_t>(old_state >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+}
+
+uint32_t RandomStream::GetLessThan(uint32_t bound) noexcept {
+    if(bound == 0u) {
+        return 0u;
+    }
+    //Lemire's multiply-shift with rejection keeps the result unbiased.
+    auto product = static_cast<uint64_t>(Next()) * bound;
+    auto low = static_cast<uint32_t>(product);
+    if(low < bound) {
+        const auto threshold = (0u - bound) % bound;
+        while(low < threshold) {
+            product = static_cast<uint64_t>(Next()) * bound;
+            low = static_cast<uint32_t>(product);
+        }
+    }
+    return static_cast<uint32_t>(product >> 32u);
+}
+
+bool RandomStream::GetBool() noexcept {
+    return (Next() >> 31u) != 0u;
+}
+
+Vector2 RandomStream::GetPointInsideDisc(Vector2 center, float radius) noexcept {
+    const auto r = radius * std::sqrt(GetZeroToOne<float>());
+    const auto theta = GetZeroToOne<float>() * 360.0f;
+    return center + Vector2::CreateFromPolarCoordinatesDegrees(r, theta);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Engine/Math/Vector2.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+//Small, seedable PCG32 generator. Each subsystem and each entity owns its own
+//stream, so results depend only on the run seed and the stream id and never
+//on the order in which entities happen to be updated.
+class RandomStream {
+public:
+    //Stream ids for subsystem-owned generators. Entity streams are keyed by spawn id
+    //and start above these so the two never overlap.
+    enum class Subsystem : uint64_t {
+        Spawning = 1
+        , Benchmark = 2
+        , First_Entity = 1024
+    };
+
+    RandomStream() noexcept;
+    explicit RandomStream(uint64_t seed, uint64_t stream) noexcept;
+    explicit RandomStream(uint64_t seed, Subsystem subsystem) noexcept;
+    RandomStream(const RandomStream& other) noexcept = default;
+    RandomStream(RandomStream&& other) noexcept = default;
+    RandomStream& operator=(const RandomStream& other) noexcept = default;
+    RandomStream& operator=(RandomStream&& other) noexcept = default;
+    ~RandomStream() noexcept = default;
+
+    void Seed(uint64_t seed, uint64_t stream) noexcept;
+
+    [[nodiscard]] uint32_t Next() noexcept;
+
+    //Uniform in [0, bound).
+    [[nodiscard]] uint32_t GetLessThan(uint32_t bound) noexcept;
+    [[nodiscard]] bool GetBool() noexcept;
+
+    template<typename T>
+    [[nodiscard]] T GetZeroToOne() noexcept;
+
+    template<typename T>
+    [[nodiscard]] T GetNegOneToOne() noexcept;
+
+    //Both ends inclusive for integers; [lower, upper) for floating point.
+    template<typename T>
+    [[nodiscard]] T GetInRange(T lower, T upper) noexcept;
+
+    [[nodiscard]] Vector2 GetPointInsideDisc(Vector2 center, float radius) noexcept;
+
+protected:
+private:
+    uint64_t m_state{0u};
+    uint64_t m_increment{1u};
+};
+
+template<typename T>
+T RandomStream::GetZeroToOne() noexcept {
+    static_assert(std::is_floating_point_v<T>, "GetZeroToOne requires a floating-point type.");
+    //24 bits fill a float mantissa exactly; doubles just get the same resolution.
+    return static_cast<T>(Next() >> 8) * static_cast<T>(1.0 / 16777216.0);
+}
+
+template<typename T>
+T RandomStream::GetNegOneToOne() noexcept {
+    return GetZeroToOne<T>() * static_cast<T>(2) - static_cast<T>(1);
+}
+
+template<typename T>
+T RandomStream::GetInRange(T lower, T upper) noexcept {
+    if constexpr(std::is_floating_point_v<T>) {
+        return lower + (upper - lower) * GetZeroToOne<T>();
+    } else {
+        static_assert(std::is_integral_v<T>, "GetInRange requires an arithmetic type.");
+        if(upper < lower) {
+            return lower;
+        }
+        const auto span = static_cast<uint32_t>(static_cast<int64_t>(upper) - static_cast<int64_t>(lower) + 1);
+        return static_cast<T>(static_cast<int64_t>(lower) + GetLessThan(span));
+    }
+}
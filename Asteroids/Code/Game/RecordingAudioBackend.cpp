@@ -0,0 +1,17 @@
+#include "Game/RecordingAudioBackend.hpp"
+
+void RecordingAudioBackend::Load([[maybe_unused]] SoundHandle sound, [[maybe_unused]] const std::filesystem::path& path, [[maybe_unused]] bool looping) noexcept {
+    m_loads.fetch_add(1u, std::memory_order_relaxed);
+}
+
+void RecordingAudioBackend::Play([[maybe_unused]] SoundHandle sound, [[maybe_unused]] float volume) noexcept {
+    m_plays.fetch_add(1u, std::memory_order_relaxed);
+}
+
+void RecordingAudioBackend::Stop([[maybe_unused]] SoundHandle sound) noexcept {
+    m_stops.fetch_add(1u, std::memory_order_relaxed);
+}
+
+RecordingAudioBackend::Stats RecordingAudioBackend::GetStats() const noexcept {
+    return Stats{m_loads.load(std::memory_order_relaxed), m_plays.load(std::memory_order_relaxed), m_stops.load(std::memory_order_relaxed)};
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Game/IAudioBackend.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+//Stand-in for the audio device that only counts what it is asked to do, so
+//headless runs can measure the command path with no audio system behind it.
+class RecordingAudioBackend : public IAudioBackend {
+public:
+    struct Stats {
+        uint64_t loads{0u};
+        uint64_t plays{0u};
+        uint64_t stops{0u};
+    };
+
+    virtual ~RecordingAudioBackend() noexcept = default;
+
+    void Load(SoundHandle sound, const std::filesystem::path& path, bool looping) noexcept override;
+    void Play(SoundHandle sound, float volume) noexcept override;
+    void Stop(SoundHandle sound) noexcept override;
+
+    //Safe to read from any thread while commands are being dispatched.
+    [[nodiscard]] Stats GetStats() const noexcept;
+
+protected:
+private:
+    std::atomic<uint64_t> m_loads{0u};
+    std::atomic<uint64_t> m_plays{0u};
+    std::atomic<uint64_t> m_stops{0u};
+};
@@ -0,0 +1,43 @@
+#include "Game/RecordingRenderBackend.hpp"
+
+#include "Engine/Renderer/Vertex3D.hpp"
+
+void RecordingRenderBackend::BeginFrame() noexcept {
+    m_commands.clear();
+    m_stats = FrameStats{};
+    m_bound_material = MaterialHandle{};
+}
+
+void RecordingRenderBackend::SetModelMatrix([[maybe_unused]] const Matrix4& transform) noexcept {
+    Push(Command{CommandType::SetModelMatrix, MaterialHandle{}, sizeof(Matrix4), 0u, 0u});
+}
+
+void RecordingRenderBackend::UpdateConstants(MaterialHandle material, [[maybe_unused]] const void* data, std::size_t byteCount) noexcept {
+    Push(Command{CommandType::UpdateConstants, material, byteCount, 0u, 0u});
+}
+
+void RecordingRenderBackend::DrawMesh(MaterialHandle material, [[maybe_unused]] const Mesh::Builder& mesh, std::size_t vertexCount, std::size_t indexCount) noexcept {
+    if(material != m_bound_material) {
+        m_bound_material = material;
+        Push(Command{CommandType::BindMaterial, material, 0u, 0u, 0u});
+    }
+    Push(Command{CommandType::Draw, material, vertexCount * sizeof(Vertex3D) + indexCount * sizeof(unsigned int), vertexCount, indexCount});
+}
+
+const std::vector<RecordingRenderBackend::Command>& RecordingRenderBackend::GetCommands() const noexcept {
+    return m_commands;
+}
+
+const RecordingRenderBackend::FrameStats& RecordingRenderBackend::GetFrameStats() const noexcept {
+    return m_stats;
+}
+
+void RecordingRenderBackend::Push(const Command& command) noexcept {
+    m_commands.push_back(command);
+    m_stats.bytesUploaded += command.bytes;
+    if(command.type == CommandType::Draw) {
+        ++m_stats.draws;
+    } else {
+        ++m_stats.stateChanges;
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Game/IRenderBackend.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//Does no GPU work; logs every command with the bytes it would upload so the
+//render path can be measured and regression tested without a device.
+//Binding the material that is already bound is not counted as a state change.
+class RecordingRenderBackend : public IRenderBackend {
+public:
+    enum class CommandType : uint8_t {
+        SetModelMatrix
+        , UpdateConstants
+        , BindMaterial
+        , Draw
+    };
+
+    struct Command {
+        CommandType type{CommandType::Draw};
+        MaterialHandle material{};
+        std::size_t bytes{0u};
+        //Draws only.
+        std::size_t vertices{0u};
+        std::size_t indices{0u};
+    };
+
+    struct FrameStats {
+        std::size_t draws{0u};
+        //Model matrix sets, constant buffer updates and material switches.
+        std::size_t stateChanges{0u};
+        std::size_t bytesUploaded{0u};
+    };
+
+    virtual ~RecordingRenderBackend() noexcept = default;
+
+    //Clears the log. The bound material is forgotten too, as a new frame starts from scratch.
+    void BeginFrame() noexcept;
+
+    void SetModelMatrix(const Matrix4& transform) noexcept override;
+    void UpdateConstants(MaterialHandle material, const void* data, std::size_t byteCount) noexcept override;
+    void DrawMesh(MaterialHandle material, const Mesh::Builder& mesh, std::size_t vertexCount, std::size_t indexCount) noexcept override;
+
+    [[nodiscard]] const std::vector<Command>& GetCommands() const noexcept;
+    [[nodiscard]] const FrameStats& GetFrameStats() const noexcept;
+
+protected:
+private:
+    void Push(const Command& command) noexcept;
+
+    std::vector<Command> m_commands{};
+    FrameStats m_stats{};
+    MaterialHandle m_bound_material{};
+};
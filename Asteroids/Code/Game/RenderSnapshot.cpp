@@ -0,0 +1,150 @@
+#include "Game/RenderSnapshot.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+void RenderSnapshot::Clear() noexcept {
+    quads.clear();
+    debugEntities.clear();
+    hud = Hud{};
+    capturedChecksum = 0u;
+}
+
+RenderSnapshotBuffer::RenderSnapshotBuffer(bool threaded /*= true*/) noexcept
+: m_threaded(threaded)
+{
+    m_states.fill(SlotState::Empty);
+    if(m_threaded) {
+        StartWorker();
+    }
+}
+
+RenderSnapshotBuffer::~RenderSnapshotBuffer() noexcept {
+    StopWorker();
+}
+
+void RenderSnapshotBuffer::SetThreaded(bool threaded) noexcept {
+    if(threaded == m_threaded) {
+        return;
+    }
+    Discard();
+    StopWorker();
+    m_threaded = threaded;
+    if(m_threaded) {
+        StartWorker();
+    }
+}
+
+bool RenderSnapshotBuffer::IsThreaded() const noexcept {
+    return m_threaded;
+}
+
+RenderSnapshot& RenderSnapshotBuffer::BeginCapture() noexcept {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_signal.wait(lock, [this] { return !IsBusy(m_capture_slot); });
+    m_states[m_capture_slot] = SlotState::Empty;
+    if(m_latest_slot == m_capture_slot) {
+        m_latest_slot = slot_count;
+    }
+    auto& snapshot = m_slots[m_capture_slot];
+    snapshot.Clear();
+    snapshot.frame = m_next_frame++;
+    return snapshot;
+}
+
+void RenderSnapshotBuffer::Publish() noexcept {
+    const auto published = m_capture_slot;
+    auto& snapshot = m_slots[published];
+    snapshot.capturedChecksum = snapshot.sprites.CalcAddedChecksum();
+    {
+        std::scoped_lock<std::mutex> lock(m_mutex);
+        m_states[published] = SlotState::Published;
+        m_capture_slot = (m_capture_slot + 1u) % slot_count;
+        if(!m_threaded) {
+            m_latest_slot = published;
+        }
+    }
+    if(m_threaded) {
+        m_signal.notify_all();
+        return;
+    }
+    snapshot.sprites.End();
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_states[published] = SlotState::Prepared;
+}
+
+const RenderSnapshot* RenderSnapshotBuffer::AcquireForDraw() noexcept {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    //Threaded, the slot published last frame is the one that will be captured into next.
+    const auto slot = m_threaded ? m_capture_slot : m_latest_slot;
+    if(slot >= slot_count) {
+        return nullptr;
+    }
+    m_signal.wait(lock, [this, slot] { return !IsBusy(slot); });
+    return m_states[slot] == SlotState::Prepared ? &m_slots[slot] : nullptr;
+}
+
+void RenderSnapshotBuffer::Discard() noexcept {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_signal.wait(lock, [this] { return !IsBusy(0u) && !IsBusy(1u); });
+    m_states.fill(SlotState::Empty);
+    m_latest_slot = slot_count;
+}
+
+void RenderSnapshotBuffer::WaitForPrepared() noexcept {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_signal.wait(lock, [this] { return !IsBusy(0u) && !IsBusy(1u); });
+}
+
+uint64_t RenderSnapshotBuffer::GetNextFrame() const noexcept {
+    //Only the capturing thread writes it.
+    return m_next_frame;
+}
+
+void RenderSnapshotBuffer::StartWorker() noexcept {
+    m_stop = false;
+    m_worker = std::thread(&RenderSnapshotBuffer::WorkerLoop, this);
+}
+
+void RenderSnapshotBuffer::StopWorker() noexcept {
+    {
+        std::scoped_lock<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_signal.notify_all();
+    if(m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+void RenderSnapshotBuffer::WorkerLoop() noexcept {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while(true) {
+        m_signal.wait(lock, [this] { return m_stop || HasPublished(); });
+        if(m_stop) {
+            return;
+        }
+        //Oldest first, so snapshots are prepared in the order they were published.
+        auto slot = slot_count;
+        for(std::size_t i = 0u; i < slot_count; ++i) {
+            if(m_states[i] == SlotState::Published && (slot == slot_count || m_slots[i].frame < m_slots[slot].frame)) {
+                slot = i;
+            }
+        }
+        m_states[slot] = SlotState::Preparing;
+        lock.unlock();
+        m_slots[slot].sprites.End();
+        lock.lock();
+        m_states[slot] = SlotState::Prepared;
+        m_latest_slot = slot;
+        m_signal.notify_all();
+    }
+}
+
+bool RenderSnapshotBuffer::IsBusy(std::size_t slot) const noexcept {
+    return m_states[slot] == SlotState::Published || m_states[slot] == SlotState::Preparing;
+}
+
+bool RenderSnapshotBuffer::HasPublished() const noexcept {
+    return std::any_of(std::cbegin(m_states), std::cend(m_states), [](SlotState state) { return state == SlotState::Published; });
+}
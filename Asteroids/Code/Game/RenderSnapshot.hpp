@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Engine/Math/Matrix4.hpp"
+#include "Engine/Math/Vector2.hpp"
+
+#include "Game/MaterialRegistry.hpp"
+#include "Game/SpriteBatch.hpp"
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//Everything MainState draws for one frame, captured by value once the
+//simulation for that frame is done. Drawing reads only the snapshot and never
+//a live entity, so the next frame can be simulated while this one is prepared.
+struct RenderSnapshot {
+    //Entities that are not sprite batched, drawn as a shared unit quad.
+    struct Quad {
+        MaterialHandle material{};
+        Matrix4 transform{};
+        float alpha{1.0f};
+    };
+
+    //What the debug overlay draws for one entity, taken at the same
+    //interpolated pose as its sprite so the two line up.
+    struct DebugEntity {
+        Vector2 position{};
+        float orientationDegrees{0.0f};
+        float cosmeticRadius{0.0f};
+        float physicalRadius{0.0f};
+        Vector2 velocity{};
+        Vector2 acceleration{};
+    };
+
+    struct Hud {
+        long long score{0ll};
+        long long lives{0ll};
+        bool paused{false};
+        bool gameOver{false};
+        float fadeOutAlpha{0.0f};
+        //Empty unless debug rendering is on.
+        std::string debugText{};
+    };
+
+    uint64_t frame{0u};
+    SpriteBatch sprites{};
+    std::vector<Quad> quads{};
+    //Empty unless debug rendering is on.
+    std::vector<DebugEntity> debugEntities{};
+    Hud hud{};
+    //CalcAddedChecksum of the sprites at capture time.
+    uint64_t capturedChecksum{0u};
+
+    void Clear() noexcept;
+};
+
+//Two RenderSnapshots passed between the simulation and a prepare thread that
+//groups and bakes the sprite vertices. The simulation captures into one
+//snapshot while the other is prepared and then drawn, so drawing lags the
+//simulation by one frame. Without a thread the snapshot is prepared inside
+//Publish and drawn the same frame.
+class RenderSnapshotBuffer {
+public:
+    explicit RenderSnapshotBuffer(bool threaded = true) noexcept;
+    RenderSnapshotBuffer(const RenderSnapshotBuffer& other) = delete;
+    RenderSnapshotBuffer(RenderSnapshotBuffer&& other) = delete;
+    RenderSnapshotBuffer& operator=(const RenderSnapshotBuffer& other) = delete;
+    RenderSnapshotBuffer& operator=(RenderSnapshotBuffer&& other) = delete;
+    ~RenderSnapshotBuffer() noexcept;
+
+    void SetThreaded(bool threaded) noexcept;
+    [[nodiscard]] bool IsThreaded() const noexcept;
+
+    //Cleared snapshot to fill; waits if it is still being prepared.
+    [[nodiscard]] RenderSnapshot& BeginCapture() noexcept;
+    void Publish() noexcept;
+    //The snapshot to draw this frame once it is prepared, or nullptr before the first one.
+    [[nodiscard]] const RenderSnapshot* AcquireForDraw() noexcept;
+    //Waits for preparation to finish and drops every snapshot, e.g. before the
+    //materials they resolved are reloaded.
+    void Discard() noexcept;
+    //Waits until every published snapshot is prepared.
+    void WaitForPrepared() noexcept;
+    //Frame number the next capture will get; the last published one is this minus one.
+    [[nodiscard]] uint64_t GetNextFrame() const noexcept;
+
+protected:
+private:
+    enum class SlotState : uint8_t {
+        Empty
+        , Published
+        , Preparing
+        , Prepared
+    };
+
+    static inline constexpr const std::size_t slot_count = 2u;
+
+    void StartWorker() noexcept;
+    void StopWorker() noexcept;
+    void WorkerLoop() noexcept;
+    [[nodiscard]] bool IsBusy(std::size_t slot) const noexcept;
+    [[nodiscard]] bool HasPublished() const noexcept;
+
+    std::array<RenderSnapshot, slot_count> m_slots{};
+    std::array<SlotState, slot_count> m_states{};
+    std::size_t m_capture_slot{0u};
+    std::size_t m_latest_slot{slot_count};
+    uint64_t m_next_frame{0u};
+    bool m_threaded{true};
+    bool m_stop{false};
+    std::mutex m_mutex{};
+    std::condition_variable m_signal{};
+    std::thread m_worker{};
+};
@@ -11,6 +11,10 @@
 
 #include "Engine/Scene/Components.hpp"
 
+#include "Engine/Services/ServiceLocator.hpp"
+#include "Engine/Services/IRendererService.hpp"
+
+#include "Game/CollisionResponse.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/Game.hpp"
 #include "Game/MainState.hpp"
@@ -21,6 +25,7 @@
 #include "Game/IWeapon.hpp"
 
 #include "Game/ThrustComponent.hpp"
+#include "Game/RenderSnapshot.hpp"
 
 #include <algorithm>
 
@@ -31,6 +36,8 @@ Ship::Ship(std::weak_ptr<Scene> scene, Vector2 position)
 {
     UpdateComponent<TransformComponent>(Matrix4::MakeRT(Matrix4::Create2DRotationDegreesMatrix(-90.0f), Matrix4::CreateTranslationMatrix(position)));
     faction = GameEntity::Faction::Player;
+    kind = GameEntity::Kind::Ship;
+    m_material = GetGameAs<Game>()->materials.ship;
     _thrust = std::move(std::make_unique<ThrustComponent>(scene, this));
 
     scoreValue = -100LL;
@@ -53,47 +60,19 @@ Ship::Ship(std::weak_ptr<Scene> scene, Vector2 position)
 
 void Ship::BeginFrame() noexcept {
     GameEntity::BeginFrame();
+    _requested_thrust = 0.0f;
+    _frameInput = PlayerInput{};
     _thrust->BeginFrame();
 }
 
 void Ship::Update(TimeUtils::FPSeconds deltaSeconds) noexcept {
     GameEntity::Update(deltaSeconds);
 
-    const auto uvs = AABB2::Zero_to_One;
-    const auto tex = GetMaterial()->GetTexture(Material::TextureID::Diffuse);
-    const auto frameWidth = static_cast<float>(tex->GetDimensions().x);
-    const auto frameHeight = static_cast<float>(tex->GetDimensions().y);
-    const auto half_extents = Vector2{frameWidth, frameHeight};
+    const auto half_extents = GetMaterialDimensions();
 
     DoScaleEaseOut(deltaSeconds);
-    {
-        const auto S = Matrix4::CreateScaleMatrix(_scale * half_extents);
-        const auto R = Matrix4::Create2DRotationDegreesMatrix(GetOrientationDegrees());
-        const auto T = Matrix4::CreateTranslationMatrix(GetPosition());
-        UpdateComponent<TransformComponent>(Matrix4::MakeSRT(S, R, T));
-    }
-    auto& builder = m_mesh_builder;
-    builder.Begin(PrimitiveType::Triangles);
-    if(IsRespawning()) {
-        builder.SetAlpha(DoAlphaEaseOut(deltaSeconds));
-    } else {
-        builder.SetColor(Rgba::White);
-    }
-
-    builder.SetUV(Vector2{uvs.maxs.x, uvs.maxs.y});
-    builder.AddVertex(Vector2{+0.5f, +0.5f});
-
-    builder.SetUV(Vector2{uvs.mins.x, uvs.maxs.y});
-    builder.AddVertex(Vector2{-0.5f, +0.5f});
-
-    builder.SetUV(Vector2{uvs.mins.x, uvs.mins.y});
-    builder.AddVertex(Vector2{-0.5f, -0.5f});
-
-    builder.SetUV(Vector2{uvs.maxs.x, uvs.mins.y});
-    builder.AddVertex(Vector2{+0.5f, -0.5f});
-
-    builder.AddIndicies(Mesh::Builder::Primitive::Quad);
-    builder.End(GetMaterial());
+    UpdateTransform(_scale * half_extents);
+    _alpha = IsRespawning() ? DoAlphaEaseOut(deltaSeconds) : 1.0f;
 
     if(!IsRespawning()) {
         _laserWeapon.Update(deltaSeconds);
@@ -102,13 +81,23 @@ void Ship::Update(TimeUtils::FPSeconds deltaSeconds) noexcept {
 
 }
 
+bool Ship::CanUpdateInParallel() const noexcept {
+    //The weapon and thrust particles go through the engine.
+    return false;
+}
+
 void Ship::Render() const noexcept {
     _thrust->Render();
-    GameEntity::Render();
+}
+
+void Ship::AppendToRenderSnapshot(RenderSnapshot& snapshot) const noexcept {
+    _thrust->AppendToRenderSnapshot(snapshot);
+    snapshot.quads.push_back(RenderSnapshot::Quad{m_material, CalcRenderTransform(), _alpha});
 }
 
 void Ship::DoScaleEaseOut(TimeUtils::FPSeconds& deltaSeconds) noexcept {
-    static float t = 0.0f;
+    //Per ship rather than static: the respawn ends when this runs out, so it has to start over with every run.
+    auto& t = _scaleEaseTime;
     static float duration = 0.66f;
     static float startScale = 4.0f;
     static float endScale = 1.0f;
@@ -127,12 +116,12 @@ void Ship::DoScaleEaseOut(TimeUtils::FPSeconds& deltaSeconds) noexcept {
 }
 
 
-float Ship::DoAlphaEaseOut(TimeUtils::FPSeconds& deltaSeconds) const noexcept {
-    static float t = 0.0f;
+float Ship::DoAlphaEaseOut(TimeUtils::FPSeconds& deltaSeconds) noexcept {
+    auto& t = _alphaEaseTime;
     static float duration = 0.66f;
     static float start = 0.0f;
     static float end = 1.0f;
-    static float a = 0.0f;
+    auto a = 0.0f;
     if(t < duration) {
         a = MathUtils::Interpolate(end, start, MathUtils::EasingFunctions::SmoothStop<3>(t / duration));
         t += deltaSeconds.count();
@@ -157,24 +146,48 @@ void Ship::OnDestroy() noexcept {
     }
     GameEntity::OnDestroy();
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        if (auto* const mainState = dynamic_cast<MainState* const>(game->GetCurrentState()); mainState != nullptr) {
-            mainState->MakeExplosion(GetPosition());
-            SetRespawning();
-            game->respawnTimer.Reset();
-        }
+        game->GetSpawnQueue().Push(SpawnRequest::ForExplosion(GetPosition()));
+        SetRespawning();
+        game->respawnTimer.Reset();
     }
 }
 
 void Ship::OnFire() noexcept {
+    RecordFire(nullptr);
     if(IsRespawning()) {
         return;
     }
     if(_laserWeapon.Fire()) {
-        MakeBullet();
+        MakeBullet(CalcNewBulletVelocity());
+    }
+}
+
+void Ship::OnFire(const Vector2& velocity) noexcept {
+    RecordFire(&velocity);
+    if(IsRespawning()) {
+        return;
+    }
+    if(_laserWeapon.Fire()) {
+        MakeBullet(velocity);
+    }
+}
+
+void Ship::RecordFire(const Vector2* velocity) noexcept {
+    //Only the first attempt in a frame can fire; later ones find the fire rate just reset.
+    if(_frameInput.buttons & PlayerInput::Button_Fire) {
+        return;
+    }
+    _frameInput.buttons |= PlayerInput::Button_Fire;
+    _frameInput.fireOrientationDegrees = GetOrientationDegrees();
+    if(velocity) {
+        _frameInput.buttons |= PlayerInput::Button_FireAtVelocity;
+        _frameInput.fireVelocityX = velocity->x;
+        _frameInput.fireVelocityY = velocity->y;
     }
 }
 
 void Ship::DropMine() noexcept {
+    _frameInput.buttons |= PlayerInput::Button_DropMine;
     if(IsRespawning()) {
         return;
     }
@@ -184,22 +197,54 @@ void Ship::DropMine() noexcept {
     }
 }
 
-Material* Ship::GetMaterial() const noexcept {
-    return g_theRenderer->GetMaterial("ship");
-}
-
 void Ship::Thrust(float force) noexcept {
     if(IsRespawning()) {
         return;
     }
     _thrust->SetThrust(force);
-    AddForce(GetForward() * force);
+    _requested_thrust += force;
 }
 
 void Ship::StopThrust() noexcept {
     _thrust->SetThrust(0.0f);
 }
 
+void Ship::ApplyThrust() noexcept {
+    if(IsRespawning() || _requested_thrust == 0.0f) {
+        return;
+    }
+    //Forward is read per tick so thrust follows the ship as it turns.
+    AddForce(GetForward() * _requested_thrust);
+}
+
+PlayerInput Ship::GetFrameInput() const noexcept {
+    auto input = _frameInput;
+    input.orientationDegrees = GetOrientationDegrees();
+    input.thrust = _requested_thrust;
+    input.hasShip = true;
+    return input;
+}
+
+void Ship::ReplayInput(const PlayerInput& input) noexcept {
+    if(input.buttons & PlayerInput::Button_Fire) {
+        SetOrientationDegrees(input.fireOrientationDegrees);
+        if(input.buttons & PlayerInput::Button_FireAtVelocity) {
+            OnFire(Vector2{input.fireVelocityX, input.fireVelocityY});
+        } else {
+            OnFire();
+        }
+    }
+    if(input.buttons & PlayerInput::Button_DropMine) {
+        DropMine();
+    }
+    SetOrientationDegrees(input.orientationDegrees);
+    if(input.thrust != 0.0f) {
+        Thrust(input.thrust);
+    } else {
+        StopThrust();
+    }
+}
+
 void Ship::SetRespawning() noexcept {
     _respawning = true;
 }
@@ -213,42 +258,41 @@ void Ship::DoneRespawning() noexcept {
 }
 
 void Ship::OnCollision(GameEntity* a, GameEntity* b) noexcept {
+    CollisionResponse::Dispatch(*a, *b);
+}
+
+void Ship::OnHitBy(Bullet& bullet) noexcept {
     if(IsRespawning()) {
         return;
     }
-    if(a->faction == b->faction) {
+    if(auto* game = GetGameAs<Game>(); game != nullptr) {
+        DecrementHealth();
+        bullet.DecrementHealth();
+        if(IsDead()) {
+            game->DecrementLives();
+        }
+    }
+}
+
+void Ship::OnHitBy([[maybe_unused]] Ufo& ufo) noexcept {
+    if(IsRespawning()) {
         return;
     }
-    switch(b->faction) {
-    case GameEntity::Faction::Enemy:
-    {
-        if(auto* game = GetGameAs<Game>(); game != nullptr) {
-            if(auto* asBullet = dynamic_cast<Bullet*>(b); asBullet != nullptr) {
-                a->DecrementHealth();
-                asBullet->DecrementHealth();
-                if(a->IsDead()) {
-                    game->DecrementLives();
-                }
-            } else if(auto* asUfo = dynamic_cast<Ufo*>(b); asUfo != nullptr) {
-                a->Kill();
-                game->DecrementLives();
-            }
-        }
+    if(auto* game = GetGameAs<Game>(); game != nullptr) {
+        Kill();
+        game->DecrementLives();
     }
-    break;
-    case GameEntity::Faction::Asteroid:
-    {
-        if(auto* game = GetGameAs<Game>(); game != nullptr) {
-            if(auto* asAsteroid = dynamic_cast<Asteroid*>(b); asAsteroid != nullptr) {
-                a->DecrementHealth();
-                if(a->IsDead()) {
-                    game->DecrementLives();
-                }
-            }
-        }
+}
+
+void Ship::OnHitBy([[maybe_unused]] Asteroid& asteroid) noexcept {
+    if(IsRespawning()) {
+        return;
     }
-    break;
-    default: break;
+    if(auto* game = GetGameAs<Game>(); game != nullptr) {
+        DecrementHealth();
+        if(IsDead()) {
+            game->DecrementLives();
+        }
     }
 }
 
@@ -256,19 +300,15 @@ void Ship::OnCreate() noexcept {
     SetRespawning();
 }
 
-void Ship::MakeBullet() const noexcept {
+void Ship::MakeBullet(const Vector2& velocity) const noexcept {
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        if (auto* const mainState = dynamic_cast<MainState* const>(game->GetCurrentState()); mainState != nullptr) {
-            mainState->MakeBullet(this, CalcNewBulletPosition(), CalcNewBulletVelocity());
-        }
+        game->GetSpawnQueue().Push(SpawnRequest::ForBullet(this, CalcNewBulletPosition(), velocity));
     }
 }
 
 void Ship::MakeMine() const noexcept {
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        if (auto* const mainState = dynamic_cast<MainState* const>(game->GetCurrentState()); mainState != nullptr) {
-            mainState->MakeMine(this, GetPosition());
-        }
+        game->GetSpawnQueue().Push(SpawnRequest::ForMine(this, GetPosition()));
     }
 }
 
@@ -282,12 +322,12 @@ const Vector2 Ship::CalcNewBulletPosition() const noexcept {
 
 const Vector2 Ship::CalcBulletDirectionFromDifficulty() const noexcept {
     const auto current_angle = GetForward().CalcHeadingDegrees();
-    const auto angle_bias = []() {
+    const auto angle_bias = [this]() {
         if(auto* game = GetGameAs<Game>(); game != nullptr) {
             switch(game->gameOptions.GetDifficulty()) {
-            case Difficulty::Easy: return MathUtils::GetRandomNegOneToOne<float>() * 2.5f;
-            case Difficulty::Normal: return MathUtils::GetRandomNegOneToOne<float>() * 5.0f;
-            case Difficulty::Hard: return MathUtils::GetRandomNegOneToOne<float>() * 10.0f;
+            case Difficulty::Easy: return GetRandom().GetNegOneToOne<float>() * 2.5f;
+            case Difficulty::Normal: return GetRandom().GetNegOneToOne<float>() * 5.0f;
+            case Difficulty::Hard: return GetRandom().GetNegOneToOne<float>() * 10.0f;
             default: return 0.0f;
             }
         }
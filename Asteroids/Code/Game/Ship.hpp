@@ -1,17 +1,21 @@
 #pragma once
 
-#include "Engine/Core/Stopwatch.hpp"
 #include "Engine/Core/TimeUtils.hpp"
 
 #include "Engine/Scene/Scene.hpp"
 
 #include "Game/GameEntity.hpp"
+#include "Game/InputLog.hpp"
 #include "Game/LaserBulletWeapon.hpp"
+#include "Game/SimStopwatch.hpp"
 
 #include <memory>
 
 class Renderer;
 class ThrustComponent;
+class Asteroid;
+class Bullet;
+class Ufo;
 
 class Ship : public GameEntity {
 public:
@@ -21,16 +25,30 @@ public:
 
     void BeginFrame() noexcept override;
     void Update(TimeUtils::FPSeconds deltaSeconds) noexcept override;
+    bool CanUpdateInParallel() const noexcept override;
     void Render() const noexcept override;
+    void AppendToRenderSnapshot(RenderSnapshot& snapshot) const noexcept override;
     void EndFrame() noexcept override;
 
     void OnCreate() noexcept override;
     void OnFire() noexcept override;
+    //Fires along velocity instead of the ship's own aim, e.g. at a target's lead.
+    void OnFire(const Vector2& velocity) noexcept;
     void OnCollision(GameEntity* a, GameEntity* b) noexcept override;
+    void OnHitBy(Bullet& bullet) noexcept;
+    void OnHitBy(Ufo& ufo) noexcept;
+    void OnHitBy(Asteroid& asteroid) noexcept;
     void OnDestroy() noexcept override;
 
+    //Input calls these once per frame; ApplyThrust turns the request into a
+    //force on every simulation tick of that frame.
     void Thrust(float force) noexcept;
     void StopThrust() noexcept;
+    void ApplyThrust() noexcept;
+
+    //Everything input asked of the ship this frame, and the way to ask it again.
+    [[nodiscard]] PlayerInput GetFrameInput() const noexcept;
+    void ReplayInput(const PlayerInput& input) noexcept;
 
     void SetRespawning() noexcept;
     const bool IsRespawning() const noexcept;
@@ -38,25 +56,31 @@ public:
 
     void DropMine() noexcept;
 
-    Material* GetMaterial() const noexcept override;
 
 private:
 
-    void MakeBullet() const noexcept;
+    //Notes the first fire attempt of the frame in the frame input.
+    void RecordFire(const Vector2* velocity) noexcept;
+    void MakeBullet(const Vector2& velocity) const noexcept;
     void MakeMine() const noexcept;
 
     void DoScaleEaseOut(TimeUtils::FPSeconds& deltaSeconds) noexcept;
-    float DoAlphaEaseOut(TimeUtils::FPSeconds& deltaSeconds) const noexcept;
+    float DoAlphaEaseOut(TimeUtils::FPSeconds& deltaSeconds) noexcept;
 
     const Vector2 CalcBulletDirectionFromDifficulty() const noexcept;
     const Vector2 CalcNewBulletVelocity() const noexcept;
     const Vector2 CalcNewBulletPosition() const noexcept;
 
     std::unique_ptr<ThrustComponent> _thrust{};
-    Stopwatch _mineFireRate;
+    SimStopwatch _mineFireRate;
     LaserBulletWeapon _laserWeapon{};
     float _maxScale{2.0f};
     float _scale{1.0f};
+    float _alpha{1.0f};
+    float _scaleEaseTime{0.0f};
+    float _alphaEaseTime{0.0f};
+    float _requested_thrust{0.0f};
+    PlayerInput _frameInput{};
     bool _canDropMine = false;
     bool _respawning = true;
 };
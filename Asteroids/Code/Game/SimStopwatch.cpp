@@ -0,0 +1,47 @@
+#include "Game/SimStopwatch.hpp"
+
+SimStopwatch::SimStopwatch(const TimeUtils::FPSeconds& seconds) noexcept {
+    SetSeconds(seconds);
+}
+
+SimStopwatch::SimStopwatch(unsigned int frequency) noexcept {
+    SetFrequency(frequency);
+}
+
+void SimStopwatch::SetSeconds(const TimeUtils::FPSeconds& seconds) noexcept {
+    m_interval = std::chrono::duration_cast<seconds_type>(seconds);
+    Reset();
+}
+
+void SimStopwatch::SetFrequency(unsigned int frequency) noexcept {
+    m_interval = frequency != 0u ? seconds_type{1.0 / static_cast<double>(frequency)} : seconds_type{};
+    Reset();
+}
+
+bool SimStopwatch::Check() const noexcept {
+    return s_now >= m_target;
+}
+
+bool SimStopwatch::CheckAndReset() noexcept {
+    if(Check()) {
+        Reset();
+        return true;
+    }
+    return false;
+}
+
+void SimStopwatch::Reset() noexcept {
+    m_target = s_now + m_interval;
+}
+
+void SimStopwatch::AdvanceClock(TimeUtils::FPSeconds step) noexcept {
+    s_now += std::chrono::duration_cast<seconds_type>(step);
+}
+
+void SimStopwatch::ResetClock() noexcept {
+    s_now = seconds_type{};
+}
+
+SimStopwatch::seconds_type SimStopwatch::GetClock() noexcept {
+    return s_now;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Engine/Core/TimeUtils.hpp"
+
+#include <chrono>
+
+//Stopwatch that runs on simulation time instead of the wall clock. The clock
+//only moves when MainState runs a tick, so gameplay timers fire on the same
+//tick however fast the frames go, paused frames included, and a replay of the
+//same seed and input reproduces them exactly.
+class SimStopwatch {
+public:
+    using seconds_type = std::chrono::duration<double>;
+
+    SimStopwatch() noexcept = default;
+    explicit SimStopwatch(const TimeUtils::FPSeconds& seconds) noexcept;
+    explicit SimStopwatch(unsigned int frequency) noexcept;
+    SimStopwatch(const SimStopwatch& other) noexcept = default;
+    SimStopwatch(SimStopwatch&& other) noexcept = default;
+    SimStopwatch& operator=(const SimStopwatch& other) noexcept = default;
+    SimStopwatch& operator=(SimStopwatch&& other) noexcept = default;
+    ~SimStopwatch() noexcept = default;
+
+    void SetSeconds(const TimeUtils::FPSeconds& seconds) noexcept;
+    void SetFrequency(unsigned int frequency) noexcept;
+
+    [[nodiscard]] bool Check() const noexcept;
+    [[nodiscard]] bool CheckAndReset() noexcept;
+    void Reset() noexcept;
+
+    //Called once per simulation tick.
+    static void AdvanceClock(TimeUtils::FPSeconds step) noexcept;
+    //Called when a run starts, so every run measures from zero.
+    static void ResetClock() noexcept;
+    [[nodiscard]] static seconds_type GetClock() noexcept;
+
+protected:
+private:
+    static inline seconds_type s_now{};
+
+    seconds_type m_interval{};
+    seconds_type m_target{};
+};
@@ -0,0 +1,63 @@
+#include "Game/SpatialHash.hpp"
+
+void SpatialHash::Rebuild(const AABB2& world_bounds, const KinematicsStore& store, const std::vector<KinematicsStore::index_type>& indices) noexcept {
+    m_items.clear();
+    m_max_radius = 0.0f;
+    for(const auto index : indices) {
+        m_max_radius = (std::max)(m_max_radius, store.physical_radius[index]);
+    }
+
+    //Cells are at least one diameter wide so a query only spans a few of them.
+    const auto world_dimensions = world_bounds.CalcDimensions();
+    const auto desired_cell_size = (std::max)(2.0f * m_max_radius, 1.0f);
+    const auto calc_cell_count = [desired_cell_size](float extent) {
+        return std::clamp(static_cast<int>(extent / desired_cell_size), 1, max_cells_per_axis);
+    };
+    m_cells_x = calc_cell_count(world_dimensions.x);
+    m_cells_y = calc_cell_count(world_dimensions.y);
+    m_origin = world_bounds.mins;
+    m_inv_cell_dimensions = Vector2{static_cast<float>(m_cells_x) / (std::max)(world_dimensions.x, 1.0f), static_cast<float>(m_cells_y) / (std::max)(world_dimensions.y, 1.0f)};
+
+    //Counting sort: tally each cell, prefix-sum into start offsets, then scatter.
+    const auto cell_count = static_cast<std::size_t>(m_cells_x) * static_cast<std::size_t>(m_cells_y);
+    m_cell_start.assign(cell_count + 1, 0);
+    if(indices.empty()) {
+        return;
+    }
+    const auto cell_of = [&](KinematicsStore::index_type index) {
+        return CalcCellIndex(CalcCellX(store.position_x[index]), CalcCellY(store.position_y[index]));
+    };
+    for(const auto index : indices) {
+        ++m_cell_start[cell_of(index) + 1];
+    }
+    for(std::size_t i = 1; i <= cell_count; ++i) {
+        m_cell_start[i] += m_cell_start[i - 1];
+    }
+    m_items.resize(indices.size());
+    m_cursor.assign(m_cell_start.begin(), m_cell_start.end() - 1);
+    for(std::size_t ordinal = 0; ordinal < indices.size(); ++ordinal) {
+        m_items[m_cursor[cell_of(indices[ordinal])]++] = ordinal;
+    }
+}
+
+std::size_t SpatialHash::Size() const noexcept {
+    return m_items.size();
+}
+
+bool SpatialHash::IsEmpty() const noexcept {
+    return m_items.empty();
+}
+
+//Clamping keeps the mapping monotonic, so a query range still covers every
+//cell an overlapping element can be in.
+int SpatialHash::CalcCellX(float x) const noexcept {
+    return std::clamp(static_cast<int>(std::floor((x - m_origin.x) * m_inv_cell_dimensions.x)), 0, m_cells_x - 1);
+}
+
+int SpatialHash::CalcCellY(float y) const noexcept {
+    return std::clamp(static_cast<int>(std::floor((y - m_origin.y) * m_inv_cell_dimensions.y)), 0, m_cells_y - 1);
+}
+
+std::size_t SpatialHash::CalcCellIndex(int x, int y) const noexcept {
+    return static_cast<std::size_t>(y) * static_cast<std::size_t>(m_cells_x) + static_cast<std::size_t>(x);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Vector2.hpp"
+
+#include "Game/KinematicsStore.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+//Uniform-grid broadphase rebuilt every frame from KinematicsStore slots.
+//The grid does not wrap at the world edges: MainState::WrapAroundWorld only
+//moves an entity once it is fully outside the world, and the narrowphase uses
+//plain distance, so nothing collides across a seam. Positions past the edges
+//are clamped into the border cells.
+//Queries report the ordinal of the element in the list passed to Rebuild.
+class SpatialHash {
+public:
+    SpatialHash() noexcept = default;
+    SpatialHash(const SpatialHash& other) = default;
+    SpatialHash(SpatialHash&& other) = default;
+    SpatialHash& operator=(const SpatialHash& other) = default;
+    SpatialHash& operator=(SpatialHash&& other) = default;
+    ~SpatialHash() noexcept = default;
+
+    void Rebuild(const AABB2& world_bounds, const KinematicsStore& store, const std::vector<KinematicsStore::index_type>& indices) noexcept;
+
+    template<typename Callback>
+    void ForEachCandidate(Vector2 position, float radius, Callback&& callback) const noexcept;
+
+    [[nodiscard]] std::size_t Size() const noexcept;
+    [[nodiscard]] bool IsEmpty() const noexcept;
+
+protected:
+private:
+    [[nodiscard]] int CalcCellX(float x) const noexcept;
+    [[nodiscard]] int CalcCellY(float y) const noexcept;
+    [[nodiscard]] std::size_t CalcCellIndex(int x, int y) const noexcept;
+
+    static inline constexpr const int max_cells_per_axis = 128;
+
+    Vector2 m_origin{};
+    Vector2 m_inv_cell_dimensions{};
+    int m_cells_x{1};
+    int m_cells_y{1};
+    float m_max_radius{0.0f};
+    std::vector<std::size_t> m_cell_start{};
+    std::vector<std::size_t> m_items{};
+    //Scatter positions while rebuilding; kept so a rebuild does not allocate.
+    std::vector<std::size_t> m_cursor{};
+};
+
+template<typename Callback>
+void SpatialHash::ForEachCandidate(Vector2 position, float radius, Callback&& callback) const noexcept {
+    if(IsEmpty()) {
+        return;
+    }
+    const auto reach = radius + m_max_radius;
+    const auto first_x = CalcCellX(position.x - reach);
+    const auto first_y = CalcCellY(position.y - reach);
+    const auto last_x = CalcCellX(position.x + reach);
+    const auto last_y = CalcCellY(position.y + reach);
+    for(auto y = first_y; y <= last_y; ++y) {
+        for(auto x = first_x; x <= last_x; ++x) {
+            const auto cell = CalcCellIndex(x, y);
+            for(auto i = m_cell_start[cell]; i < m_cell_start[cell + 1]; ++i) {
+                callback(m_items[i]);
+            }
+        }
+    }
+}
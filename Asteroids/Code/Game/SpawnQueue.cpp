@@ -0,0 +1,89 @@
+#include "Game/SpawnQueue.hpp"
+
+#include <iterator>
+
+thread_local SpawnQueue* SpawnQueue::s_bound_queue = nullptr;
+thread_local std::size_t SpawnQueue::s_bound_lane = 0u;
+
+SpawnRequest SpawnRequest::ForAsteroid(uint8_t asteroidType, Vector2 position, Vector2 velocity, float rotationSpeed) noexcept {
+    return SpawnRequest{Type::Asteroid, asteroidType, rotationSpeed, position, velocity, nullptr};
+}
+
+SpawnRequest SpawnRequest::ForBullet(const GameEntity* parent, Vector2 position, Vector2 velocity) noexcept {
+    return SpawnRequest{Type::Bullet, 0u, 0.0f, position, velocity, parent};
+}
+
+SpawnRequest SpawnRequest::ForExplosion(Vector2 position) noexcept {
+    return SpawnRequest{Type::Explosion, 0u, 0.0f, position, Vector2::Zero, nullptr};
+}
+
+SpawnRequest SpawnRequest::ForMine(const GameEntity* parent, Vector2 position) noexcept {
+    return SpawnRequest{Type::Mine, 0u, 0.0f, position, Vector2::Zero, parent};
+}
+
+SpawnRequest SpawnRequest::ForUfo(uint8_t ufoType, Vector2 position) noexcept {
+    return SpawnRequest{Type::Ufo, ufoType, 0.0f, position, Vector2::Zero, nullptr};
+}
+
+SpawnQueue::ScopedLane::ScopedLane(SpawnQueue& queue, std::size_t lane) noexcept
+: m_previous_queue(s_bound_queue)
+, m_previous_lane(s_bound_lane)
+{
+    s_bound_queue = &queue;
+    s_bound_lane = lane;
+}
+
+SpawnQueue::ScopedLane::~ScopedLane() noexcept {
+    s_bound_queue = m_previous_queue;
+    s_bound_lane = m_previous_lane;
+}
+
+void SpawnQueue::ReserveLanes(std::size_t laneCount) noexcept {
+    //Lanes are only ever emptied, so their capacity carries over to later ticks.
+    if(m_lanes.size() < laneCount) {
+        m_lanes.resize(laneCount);
+    }
+}
+
+void SpawnQueue::Push(const SpawnRequest& request) noexcept {
+    if(s_bound_queue == this) {
+        m_lanes[s_bound_lane].push_back(request);
+        return;
+    }
+    std::scoped_lock<std::mutex> lock(m_shared_mutex);
+    m_shared.push_back(request);
+}
+
+const std::vector<SpawnRequest>& SpawnQueue::Collect() noexcept {
+    m_collected.clear();
+    m_counts.fill(0u);
+    const auto append = [this](std::vector<SpawnRequest>& requests) {
+        for(const auto& request : requests) {
+            ++m_counts[static_cast<std::size_t>(request.type)];
+        }
+        m_collected.insert(std::end(m_collected), std::cbegin(requests), std::cend(requests));
+        requests.clear();
+    };
+    for(auto& lane : m_lanes) {
+        append(lane);
+    }
+    {
+        std::scoped_lock<std::mutex> lock(m_shared_mutex);
+        append(m_shared);
+    }
+    return m_collected;
+}
+
+const SpawnQueue::Counts& SpawnQueue::GetCollectedCounts() const noexcept {
+    return m_counts;
+}
+
+void SpawnQueue::Clear() noexcept {
+    for(auto& lane : m_lanes) {
+        lane.clear();
+    }
+    std::scoped_lock<std::mutex> lock(m_shared_mutex);
+    m_shared.clear();
+    m_collected.clear();
+    m_counts.fill(0u);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Engine/Math/Vector2.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class GameEntity;
+
+//Everything needed to create one entity later, on the thread that owns the world.
+struct SpawnRequest {
+    enum class Type : uint8_t {
+        Asteroid
+        , Bullet
+        , Explosion
+        , Mine
+        , Ufo
+        , Max
+    };
+
+    Type type{Type::Explosion};
+    //Asteroid::Type or Ufo::Type, depending on type.
+    uint8_t variant{0u};
+    float rotationSpeed{0.0f};
+    Vector2 position{};
+    Vector2 velocity{};
+    //Must still be alive when the request is committed.
+    const GameEntity* parent{nullptr};
+
+    [[nodiscard]] static SpawnRequest ForAsteroid(uint8_t asteroidType, Vector2 position, Vector2 velocity, float rotationSpeed) noexcept;
+    [[nodiscard]] static SpawnRequest ForBullet(const GameEntity* parent, Vector2 position, Vector2 velocity) noexcept;
+    [[nodiscard]] static SpawnRequest ForExplosion(Vector2 position) noexcept;
+    [[nodiscard]] static SpawnRequest ForMine(const GameEntity* parent, Vector2 position) noexcept;
+    [[nodiscard]] static SpawnRequest ForUfo(uint8_t ufoType, Vector2 position) noexcept;
+};
+
+//Spawn requests gathered from anywhere during a tick and committed in one go.
+//A parallel job binds its chunk to a lane of its own, so pushes from workers
+//take no lock; pushes from anywhere else share one locked lane. Collect hands
+//back the lanes in order followed by the shared lane, so the spawn order does
+//not depend on how the chunks were spread over the threads.
+class SpawnQueue {
+public:
+    using Counts = std::array<std::size_t, static_cast<std::size_t>(SpawnRequest::Type::Max)>;
+
+    //Routes Push calls on this thread into lane for its lifetime.
+    class ScopedLane {
+    public:
+        ScopedLane(SpawnQueue& queue, std::size_t lane) noexcept;
+        ScopedLane(const ScopedLane& other) = delete;
+        ScopedLane(ScopedLane&& other) = delete;
+        ScopedLane& operator=(const ScopedLane& other) = delete;
+        ScopedLane& operator=(ScopedLane&& other) = delete;
+        ~ScopedLane() noexcept;
+
+    protected:
+    private:
+        SpawnQueue* m_previous_queue{nullptr};
+        std::size_t m_previous_lane{0u};
+    };
+
+    SpawnQueue() noexcept = default;
+    SpawnQueue(const SpawnQueue& other) = delete;
+    SpawnQueue(SpawnQueue&& other) = delete;
+    SpawnQueue& operator=(const SpawnQueue& other) = delete;
+    SpawnQueue& operator=(SpawnQueue&& other) = delete;
+    ~SpawnQueue() noexcept = default;
+
+    //Makes room for laneCount lanes. Called before the job that binds them starts.
+    void ReserveLanes(std::size_t laneCount) noexcept;
+    //Safe from any thread.
+    void Push(const SpawnRequest& request) noexcept;
+
+    //Moves every pending request out, in commit order, and counts them by type.
+    //Requests pushed while the result is in use wait for the next Collect.
+    [[nodiscard]] const std::vector<SpawnRequest>& Collect() noexcept;
+    [[nodiscard]] const Counts& GetCollectedCounts() const noexcept;
+    //Drops everything still pending, e.g. when the world it was meant for goes away.
+    void Clear() noexcept;
+
+protected:
+private:
+    static thread_local SpawnQueue* s_bound_queue;
+    static thread_local std::size_t s_bound_lane;
+
+    std::vector<std::vector<SpawnRequest>> m_lanes{};
+    std::mutex m_shared_mutex{};
+    std::vector<SpawnRequest> m_shared{};
+    std::vector<SpawnRequest> m_collected{};
+    Counts m_counts{};
+};
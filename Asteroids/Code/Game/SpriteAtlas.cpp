@@ -0,0 +1,292 @@
+#include "Game/SpriteAtlas.hpp"
+
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/Rgba.hpp"
+
+#include "Engine/Math/Vector2.hpp"
+
+#include "Game/JobSystem.hpp"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <system_error>
+
+namespace {
+
+constexpr const std::array<char, 4> manifest_magic{'A', 'T', 'L', 'S'};
+
+template<typename T>
+void WriteValue(std::ofstream& ofs, const T& value) noexcept {
+    ofs.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+[[nodiscard]] bool ReadValue(std::ifstream& ifs, T& value) noexcept {
+    return static_cast<bool>(ifs.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+void WriteString(std::ofstream& ofs, const std::string& value) noexcept {
+    WriteValue(ofs, static_cast<uint32_t>(value.size()));
+    ofs.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+[[nodiscard]] bool ReadString(std::ifstream& ifs, std::string& value) noexcept {
+    uint32_t length{0u};
+    if(!ReadValue(ifs, length)) {
+        return false;
+    }
+    value.resize(length);
+    return static_cast<bool>(ifs.read(value.data(), length));
+}
+
+} // namespace
+
+bool SpriteAtlas::Build(const std::vector<Source>& sources, const std::filesystem::path& imagePath, const std::filesystem::path& manifestPath, JobSystem* jobs /*= nullptr*/) noexcept {
+    m_regions.clear();
+    m_dimensions = IntVector2{};
+    std::error_code ec{};
+    if(std::filesystem::exists(imagePath, ec) && LoadManifest(manifestPath, CalcStamps(sources))) {
+        return true;
+    }
+    return PackAndWrite(sources, imagePath, manifestPath, jobs);
+}
+
+void SpriteAtlas::Bind(MaterialRegistry& registry, std::string_view atlasMaterial) noexcept {
+    m_uvs_by_material.clear();
+    m_material = MaterialHandle{};
+    if(m_regions.empty()) {
+        return;
+    }
+    m_material = registry.Register(atlasMaterial);
+    const auto atlas_dims = Vector2{static_cast<float>(m_dimensions.x), static_cast<float>(m_dimensions.y)};
+    for(const auto& region : m_regions) {
+        const auto handle = registry.Register(region.material);
+        if(m_uvs_by_material.size() <= handle.index) {
+            m_uvs_by_material.resize(handle.index + 1u);
+        }
+        const auto mins = Vector2{static_cast<float>(region.position.x), static_cast<float>(region.position.y)};
+        const auto maxs = mins + Vector2{static_cast<float>(region.dimensions.x), static_cast<float>(region.dimensions.y)};
+        m_uvs_by_material[handle.index] = AABB2{Vector2{mins.x / atlas_dims.x, mins.y / atlas_dims.y}, Vector2{maxs.x / atlas_dims.x, maxs.y / atlas_dims.y}};
+    }
+}
+
+bool SpriteAtlas::Remap(MaterialHandle& material, AABB2& uvs) const noexcept {
+    if(material.index >= m_uvs_by_material.size() || !m_uvs_by_material[material.index]) {
+        return false;
+    }
+    const auto& region = *m_uvs_by_material[material.index];
+    const auto size = region.maxs - region.mins;
+    const auto mins = Vector2{region.mins.x + uvs.mins.x * size.x, region.mins.y + uvs.mins.y * size.y};
+    const auto maxs = Vector2{region.mins.x + uvs.maxs.x * size.x, region.mins.y + uvs.maxs.y * size.y};
+    uvs = AABB2{mins, maxs};
+    material = m_material;
+    return true;
+}
+
+MaterialHandle SpriteAtlas::GetMaterial() const noexcept {
+    return m_material;
+}
+
+const std::vector<SpriteAtlas::Region>& SpriteAtlas::GetRegions() const noexcept {
+    return m_regions;
+}
+
+IntVector2 SpriteAtlas::GetDimensions() const noexcept {
+    return m_dimensions;
+}
+
+std::optional<IntVector2> SpriteAtlas::Pack(std::vector<Region>& regions) noexcept {
+    //Tallest first keeps each shelf tight; stable so equal heights keep their order.
+    std::vector<std::size_t> order(regions.size());
+    std::iota(std::begin(order), std::end(order), std::size_t{0u});
+    std::stable_sort(std::begin(order), std::end(order), [&regions](std::size_t a, std::size_t b) {
+        return regions[a].dimensions.y > regions[b].dimensions.y;
+    });
+    for(auto dimension = min_dimension; dimension <= max_dimension; dimension *= 2) {
+        if(PackInto(regions, order, dimension)) {
+            return IntVector2{dimension, dimension};
+        }
+    }
+    return {};
+}
+
+bool SpriteAtlas::PackInto(std::vector<Region>& regions, const std::vector<std::size_t>& order, int dimension) noexcept {
+    auto x = 0;
+    auto y = 0;
+    auto shelf_height = 0;
+    for(const auto i : order) {
+        auto& region = regions[i];
+        const auto slot_width = region.dimensions.x + 2 * padding;
+        const auto slot_height = region.dimensions.y + 2 * padding;
+        if(x + slot_width > dimension) {
+            x = 0;
+            y += shelf_height;
+            shelf_height = 0;
+        }
+        if(x + slot_width > dimension || y + slot_height > dimension) {
+            return false;
+        }
+        region.position = IntVector2{x + padding, y + padding};
+        x += slot_width;
+        shelf_height = (std::max)(shelf_height, slot_height);
+    }
+    return true;
+}
+
+std::vector<SpriteAtlas::Stamp> SpriteAtlas::CalcStamps(const std::vector<Source>& sources) noexcept {
+    namespace FS = std::filesystem;
+    std::vector<Stamp> stamps{};
+    stamps.reserve(sources.size());
+    for(const auto& source : sources) {
+        Stamp stamp{source.material, source.image.generic_string(), missing_size, 0};
+        std::error_code size_ec{};
+        std::error_code time_ec{};
+        const auto size = FS::file_size(source.image, size_ec);
+        const auto time = FS::last_write_time(source.image, time_ec);
+        if(!size_ec && !time_ec) {
+            stamp.size = static_cast<uint64_t>(size);
+            stamp.writeTime = static_cast<int64_t>(time.time_since_epoch().count());
+        }
+        stamps.push_back(std::move(stamp));
+    }
+    return stamps;
+}
+
+bool SpriteAtlas::PackAndWrite(const std::vector<Source>& sources, const std::filesystem::path& imagePath, const std::filesystem::path& manifestPath, JobSystem* jobs) noexcept {
+    //Decoded into per-source slots so the parallel and serial paths keep the same order.
+    std::vector<std::unique_ptr<Image>> decoded(sources.size());
+    const auto decode = [&](std::size_t /*chunk*/, std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i) {
+            std::error_code ec{};
+            if(std::filesystem::exists(sources[i].image, ec)) {
+                decoded[i] = std::make_unique<Image>(sources[i].image);
+            }
+        }
+    };
+    if(jobs) {
+        jobs->ParallelFor(sources.size(), 1u, decode);
+    } else {
+        decode(0u, 0u, sources.size());
+    }
+    std::vector<std::unique_ptr<Image>> images{};
+    std::vector<Region> regions{};
+    for(std::size_t i = 0u; i < sources.size(); ++i) {
+        if(!decoded[i]) {
+            continue;
+        }
+        const auto dims = decoded[i]->GetDimensions();
+        if(dims.x <= 0 || dims.y <= 0) {
+            continue;
+        }
+        regions.push_back(Region{sources[i].material, IntVector2{}, dims});
+        images.push_back(std::move(decoded[i]));
+    }
+    if(regions.empty()) {
+        return false;
+    }
+    const auto atlas_dims = Pack(regions);
+    if(!atlas_dims) {
+        return false;
+    }
+    Image atlas(static_cast<unsigned int>(atlas_dims->x), static_cast<unsigned int>(atlas_dims->y));
+    for(std::size_t i = 0u; i < regions.size(); ++i) {
+        const auto& region = regions[i];
+        const auto& image = *images[i];
+        for(auto y = -padding; y < region.dimensions.y + padding; ++y) {
+            for(auto x = -padding; x < region.dimensions.x + padding; ++x) {
+                const auto source_texel = IntVector2{std::clamp(x, 0, region.dimensions.x - 1), std::clamp(y, 0, region.dimensions.y - 1)};
+                atlas.SetTexel(IntVector2{region.position.x + x, region.position.y + y}, image.GetTexel(source_texel));
+            }
+        }
+    }
+    std::error_code ec{};
+    std::filesystem::create_directories(imagePath.parent_path(), ec);
+    if(!atlas.Export(imagePath)) {
+        return false;
+    }
+    m_regions = std::move(regions);
+    m_dimensions = *atlas_dims;
+    //The atlas is usable this run even if the manifest cannot be saved; it will just be repacked next time.
+    (void)SaveManifest(manifestPath, CalcStamps(sources));
+    return true;
+}
+
+bool SpriteAtlas::LoadManifest(const std::filesystem::path& manifestPath, const std::vector<Stamp>& stamps) noexcept {
+    std::ifstream ifs{manifestPath, std::ios_base::binary};
+    if(!ifs) {
+        return false;
+    }
+    std::array<char, 4> magic{};
+    uint32_t version{0u};
+    int32_t width{0};
+    int32_t height{0};
+    uint32_t count{0u};
+    if(!ReadValue(ifs, magic) || magic != manifest_magic || !ReadValue(ifs, version) || version != manifest_version) {
+        return false;
+    }
+    uint32_t source_count{0u};
+    if(!ReadValue(ifs, source_count) || source_count != stamps.size()) {
+        return false;
+    }
+    //Same sources in the same order, none of them touched since.
+    for(const auto& expected : stamps) {
+        Stamp stamp{};
+        if(!ReadString(ifs, stamp.material) || !ReadString(ifs, stamp.image) || !ReadValue(ifs, stamp.size) || !ReadValue(ifs, stamp.writeTime)) {
+            return false;
+        }
+        if(stamp.material != expected.material || stamp.image != expected.image || stamp.size != expected.size || stamp.writeTime != expected.writeTime) {
+            return false;
+        }
+    }
+    if(!ReadValue(ifs, width) || !ReadValue(ifs, height) || !ReadValue(ifs, count) || width <= 0 || height <= 0) {
+        return false;
+    }
+    std::vector<Region> regions{};
+    regions.reserve(count);
+    for(uint32_t i = 0u; i < count; ++i) {
+        Region region{};
+        int32_t x{0};
+        int32_t y{0};
+        int32_t w{0};
+        int32_t h{0};
+        if(!ReadString(ifs, region.material) || !ReadValue(ifs, x) || !ReadValue(ifs, y) || !ReadValue(ifs, w) || !ReadValue(ifs, h)) {
+            return false;
+        }
+        region.position = IntVector2{x, y};
+        region.dimensions = IntVector2{w, h};
+        regions.push_back(std::move(region));
+    }
+    m_regions = std::move(regions);
+    m_dimensions = IntVector2{width, height};
+    return true;
+}
+
+bool SpriteAtlas::SaveManifest(const std::filesystem::path& manifestPath, const std::vector<Stamp>& stamps) const noexcept {
+    std::ofstream ofs{manifestPath, std::ios_base::binary | std::ios_base::trunc};
+    if(!ofs) {
+        return false;
+    }
+    WriteValue(ofs, manifest_magic);
+    WriteValue(ofs, manifest_version);
+    WriteValue(ofs, static_cast<uint32_t>(stamps.size()));
+    for(const auto& stamp : stamps) {
+        WriteString(ofs, stamp.material);
+        WriteString(ofs, stamp.image);
+        WriteValue(ofs, stamp.size);
+        WriteValue(ofs, stamp.writeTime);
+    }
+    WriteValue(ofs, static_cast<int32_t>(m_dimensions.x));
+    WriteValue(ofs, static_cast<int32_t>(m_dimensions.y));
+    WriteValue(ofs, static_cast<uint32_t>(m_regions.size()));
+    for(const auto& region : m_regions) {
+        WriteString(ofs, region.material);
+        WriteValue(ofs, static_cast<int32_t>(region.position.x));
+        WriteValue(ofs, static_cast<int32_t>(region.position.y));
+        WriteValue(ofs, static_cast<int32_t>(region.dimensions.x));
+        WriteValue(ofs, static_cast<int32_t>(region.dimensions.y));
+    }
+    return static_cast<bool>(ofs);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/IntVector2.hpp"
+
+#include "Game/MaterialRegistry.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class JobSystem;
+
+//Packs the gameplay sprite sheets into a single texture so sprites of every
+//entity type can share one material and one draw. The packed layout is saved
+//as a binary manifest next to the atlas image, together with the source list
+//and each source's size and write time, and reused until any of those change.
+//Sheet-space UVs are remapped into atlas space when sprites are batched.
+class SpriteAtlas {
+public:
+    struct Source {
+        std::string material{};
+        std::filesystem::path image{};
+    };
+
+    //Texel rectangle of one source image inside the atlas.
+    struct Region {
+        std::string material{};
+        IntVector2 position{};
+        IntVector2 dimensions{};
+    };
+
+    //Border around every region, filled by clamping the region's edge texels,
+    //so filtering never samples a neighbour.
+    static inline constexpr const int padding = 2;
+    static inline constexpr const int min_dimension = 256;
+    static inline constexpr const int max_dimension = 4096;
+    static inline constexpr const uint32_t manifest_version = 2u;
+
+    SpriteAtlas() noexcept = default;
+    SpriteAtlas(const SpriteAtlas& other) = delete;
+    SpriteAtlas(SpriteAtlas&& other) = delete;
+    SpriteAtlas& operator=(const SpriteAtlas& other) = delete;
+    SpriteAtlas& operator=(SpriteAtlas&& other) = delete;
+    ~SpriteAtlas() noexcept = default;
+
+    //Loads the manifest if it is up to date, otherwise packs the sources and
+    //writes a new atlas image and manifest. False if nothing usable came of it.
+    //With jobs, the source images are decoded in parallel.
+    bool Build(const std::vector<Source>& sources, const std::filesystem::path& imagePath, const std::filesystem::path& manifestPath, JobSystem* jobs = nullptr) noexcept;
+    //Resolves the region material names and the atlas material to handles.
+    void Bind(MaterialRegistry& registry, std::string_view atlasMaterial) noexcept;
+
+    //Swaps material for the atlas material and maps uvs from the sheet into
+    //its region. Returns false and leaves both alone if material is not packed.
+    bool Remap(MaterialHandle& material, AABB2& uvs) const noexcept;
+
+    [[nodiscard]] MaterialHandle GetMaterial() const noexcept;
+    [[nodiscard]] const std::vector<Region>& GetRegions() const noexcept;
+    [[nodiscard]] IntVector2 GetDimensions() const noexcept;
+
+    //Assigns a position to every region. Returns the smallest square power of
+    //two atlas that fits them all, or nothing if even max_dimension is too small.
+    [[nodiscard]] static std::optional<IntVector2> Pack(std::vector<Region>& regions) noexcept;
+
+protected:
+private:
+    [[nodiscard]] static bool PackInto(std::vector<Region>& regions, const std::vector<std::size_t>& order, int dimension) noexcept;
+    //What the manifest remembers of a source to tell whether it changed.
+    struct Stamp {
+        std::string material{};
+        std::string image{};
+        //missing_size if the image did not exist.
+        uint64_t size{0u};
+        int64_t writeTime{0};
+    };
+
+    static inline constexpr const uint64_t missing_size = (std::numeric_limits<uint64_t>::max)();
+
+    [[nodiscard]] static std::vector<Stamp> CalcStamps(const std::vector<Source>& sources) noexcept;
+    bool PackAndWrite(const std::vector<Source>& sources, const std::filesystem::path& imagePath, const std::filesystem::path& manifestPath, JobSystem* jobs) noexcept;
+    //False if the manifest is unreadable or was written for different sources.
+    bool LoadManifest(const std::filesystem::path& manifestPath, const std::vector<Stamp>& stamps) noexcept;
+    bool SaveManifest(const std::filesystem::path& manifestPath, const std::vector<Stamp>& stamps) const noexcept;
+
+    std::vector<Region> m_regions{};
+    IntVector2 m_dimensions{};
+    MaterialHandle m_material{};
+    //Atlas-space UV rectangle per MaterialHandle index; empty for unpacked materials.
+    std::vector<std::optional<AABB2>> m_uvs_by_material{};
+};
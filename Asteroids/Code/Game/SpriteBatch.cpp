@@ -0,0 +1,189 @@
+#include "Game/SpriteBatch.hpp"
+
+#include "Game/IRenderBackend.hpp"
+#include "Game/SpriteAtlas.hpp"
+
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Matrix4.hpp"
+#include "Engine/Math/Vector3.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+void SpriteBatch::SetStateMode(StateMode mode) noexcept {
+    m_state_mode = mode;
+}
+
+SpriteBatch::StateMode SpriteBatch::GetStateMode() const noexcept {
+    return m_state_mode;
+}
+
+void SpriteBatch::SetAtlas(const SpriteAtlas* atlas) noexcept {
+    m_atlas = atlas;
+}
+
+void SpriteBatch::Begin(const MaterialRegistry& registry) noexcept {
+    m_registry = &registry;
+    m_entries.clear();
+    m_instances.clear();
+    m_draws.clear();
+}
+
+void SpriteBatch::Add(MaterialHandle material, SpriteInstance instance, bool hasState /*= false*/) noexcept {
+    if(!material.IsValid()) {
+        return;
+    }
+    //Keep the sprite on its own material when the atlas material failed to load.
+    if(m_atlas && m_registry->GetMaterial(m_atlas->GetMaterial()) != nullptr && m_atlas->Remap(material, instance.uvs)) {
+        //Sprites of every type share the atlas material's state buffer, so
+        //each of its draws writes the state, even if that is all zeroes.
+        hasState = true;
+    }
+    //Only constant buffer state has to be uniform across a draw.
+    const auto split_on_state = hasState && m_state_mode == StateMode::ConstantBuffer;
+    const auto state = split_on_state ? instance.state : Vector4::Zero;
+    m_entries.push_back(Entry{FindOrAddDraw(material, split_on_state, state), instance});
+}
+
+void SpriteBatch::End() noexcept {
+    //Stable so draws keep submission order and instances keep their order within a draw.
+    std::stable_sort(std::begin(m_entries), std::end(m_entries), [](const Entry& a, const Entry& b) { return a.draw < b.draw; });
+    m_instances.reserve(m_entries.size());
+    for(const auto& entry : m_entries) {
+        auto& draw = m_draws[entry.draw];
+        if(draw.instanceCount == 0u) {
+            draw.firstInstance = m_instances.size();
+        }
+        ++draw.instanceCount;
+        m_instances.push_back(entry.instance);
+    }
+    if(m_builders.size() < m_draws.size()) {
+        m_builders.resize(m_draws.size());
+    }
+    for(std::size_t i = 0u; i < m_draws.size(); ++i) {
+        BuildMesh(m_draws[i], m_builders[i]);
+    }
+}
+
+void SpriteBatch::Render(IRenderBackend& backend) const noexcept {
+    //Vertices are already in world space.
+    backend.SetModelMatrix(Matrix4::I);
+    for(std::size_t i = 0u; i < m_draws.size(); ++i) {
+        const auto& draw = m_draws[i];
+        if(draw.hasState) {
+            backend.UpdateConstants(draw.material, &draw.state, sizeof(draw.state));
+        }
+        backend.DrawMesh(draw.material, m_builders[i], draw.instanceCount * vertices_per_sprite, draw.instanceCount * indices_per_sprite);
+    }
+}
+
+SpriteBatch::Submission SpriteBatch::Record() const noexcept {
+    Submission submission{};
+    submission.draws = m_draws.size();
+    submission.stateUploads = static_cast<std::size_t>(std::count_if(std::cbegin(m_draws), std::cend(m_draws), [](const Draw& draw) { return draw.hasState; }));
+    submission.vertices = m_instances.size() * vertices_per_sprite;
+    return submission;
+}
+
+const std::vector<SpriteInstance>& SpriteBatch::GetInstances() const noexcept {
+    return m_instances;
+}
+
+const std::vector<SpriteBatch::Draw>& SpriteBatch::GetDraws() const noexcept {
+    return m_draws;
+}
+
+std::size_t SpriteBatch::GetDrawCallCount() const noexcept {
+    return m_draws.size();
+}
+
+std::size_t SpriteBatch::GetInstanceCount() const noexcept {
+    //Entries are complete as soon as the sprites are added; instances only after End.
+    return m_entries.size();
+}
+
+uint64_t SpriteBatch::CalcAddedChecksum() const noexcept {
+    uint64_t sum = 0u;
+    for(const auto& entry : m_entries) {
+        sum += HashInstance(entry.instance);
+    }
+    return sum;
+}
+
+uint64_t SpriteBatch::CalcGroupedChecksum() const noexcept {
+    uint64_t sum = 0u;
+    for(const auto& instance : m_instances) {
+        sum += HashInstance(instance);
+    }
+    return sum;
+}
+
+uint64_t SpriteBatch::HashInstance(const SpriteInstance& instance) noexcept {
+    //FNV-1a over the fields that end up in the vertices.
+    uint64_t hash = 14695981039346656037ull;
+    const auto mix = [&hash](float value) {
+        uint32_t bits{};
+        std::memcpy(&bits, &value, sizeof(bits));
+        for(auto i = 0; i < 4; ++i) {
+            hash ^= (bits >> (i * 8)) & 0xFFu;
+            hash *= 1099511628211ull;
+        }
+    };
+    for(const auto value : {instance.position.x, instance.position.y, instance.scale.x, instance.scale.y, instance.orientationDegrees
+                           , instance.uvs.mins.x, instance.uvs.mins.y, instance.uvs.maxs.x, instance.uvs.maxs.y
+                           , instance.state.x, instance.state.y, instance.state.z, instance.state.w}) {
+        mix(value);
+    }
+    return hash;
+}
+
+std::size_t SpriteBatch::FindOrAddDraw(MaterialHandle material, bool hasState, const Vector4& state) noexcept {
+    //A frame has a handful of groups at most; a linear scan beats hashing here.
+    const auto found = std::find_if(std::cbegin(m_draws), std::cend(m_draws), [&](const Draw& draw) {
+        return draw.material == material && draw.hasState == hasState && draw.state == state;
+    });
+    if(found != std::cend(m_draws)) {
+        return static_cast<std::size_t>(std::distance(std::cbegin(m_draws), found));
+    }
+    m_draws.push_back(Draw{material, m_registry->GetMaterial(material), hasState, state, 0u, 0u});
+    return m_draws.size() - 1u;
+}
+
+void SpriteBatch::BuildMesh(const Draw& draw, Mesh::Builder& builder) const noexcept {
+    builder.Clear();
+    builder.Begin(PrimitiveType::Triangles);
+    const auto first = std::cbegin(m_instances) + draw.firstInstance;
+    const auto last = first + draw.instanceCount;
+    for(auto iter = first; iter != last; ++iter) {
+        const auto& instance = *iter;
+        const auto radians = MathUtils::ConvertDegreesToRadians(instance.orientationDegrees);
+        const auto c = std::cos(radians);
+        const auto s = std::sin(radians);
+        const auto corner = [&](float x, float y) {
+            const auto sx = x * instance.scale.x;
+            const auto sy = y * instance.scale.y;
+            return Vector2{instance.position.x + sx * c - sy * s, instance.position.y + sx * s + sy * c};
+        };
+        const auto& uvs = instance.uvs;
+        builder.SetColor(instance.tint);
+        //Sprites have no use for a normal, so it carries the per-instance state.
+        builder.SetNormal(Vector3{instance.state.x, instance.state.y, instance.state.z});
+
+        builder.SetUV(Vector2{uvs.maxs.x, uvs.maxs.y});
+        builder.AddVertex(corner(+0.5f, +0.5f));
+
+        builder.SetUV(Vector2{uvs.mins.x, uvs.maxs.y});
+        builder.AddVertex(corner(-0.5f, +0.5f));
+
+        builder.SetUV(Vector2{uvs.mins.x, uvs.mins.y});
+        builder.AddVertex(corner(-0.5f, -0.5f));
+
+        builder.SetUV(Vector2{uvs.maxs.x, uvs.mins.y});
+        builder.AddVertex(corner(+0.5f, -0.5f));
+
+        builder.AddIndicies(Mesh::Builder::Primitive::Quad);
+    }
+    builder.End(draw.resolvedMaterial);
+}
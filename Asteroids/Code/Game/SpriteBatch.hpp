@@ -0,0 +1,124 @@
+#pragma once
+
+#include "Engine/Core/Rgba.hpp"
+
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Vector2.hpp"
+#include "Engine/Math/Vector4.hpp"
+
+#include "Engine/Renderer/Mesh.hpp"
+
+#include "Game/MaterialRegistry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class IRenderBackend;
+class Material;
+class SpriteAtlas;
+
+//Per-sprite data collected for one frame.
+struct SpriteInstance {
+    Vector2 position{};
+    Vector2 scale{1.0f, 1.0f};
+    float orientationDegrees{0.0f};
+    AABB2 uvs{AABB2::Zero_to_One};
+    Rgba tint{Rgba::White};
+    //Per-sprite shader state, e.g. the hit flag and style index.
+    Vector4 state{};
+};
+
+//Collects sprites for a frame and draws them grouped by material: one vertex
+//stream and one draw call per group instead of one per entity.
+//Begin/Add/End only touch CPU memory, so the result can be inspected without a device.
+//This is not instancing: End still expands every sprite into 4 world-space
+//vertices and 6 indices each frame, and Mesh::Render uploads each group's
+//stream in full. The builders keep their capacity, so that costs no allocations.
+class SpriteBatch {
+public:
+    enum class StateMode : uint8_t {
+        //State goes to the material's first constant buffer, one update per draw,
+        //so every distinct state splits off its own draw.
+        ConstantBuffer
+        //State is written into each vertex's normal; no buffer updates at all.
+        //entity.hlsl and ufo.hlsl read it from NORMAL.
+        , Vertex
+        , Max
+    };
+    static inline constexpr const StateMode default_state_mode = StateMode::Vertex;
+
+    struct Draw {
+        MaterialHandle material{};
+        //Resolved when the draw is created so End and Render never touch the registry.
+        Material* resolvedMaterial{nullptr};
+        bool hasState{false};
+        Vector4 state{};
+        std::size_t firstInstance{0u};
+        std::size_t instanceCount{0u};
+    };
+
+    //What Render sends to the device for the current batch.
+    struct Submission {
+        std::size_t draws{0u};
+        std::size_t stateUploads{0u};
+        std::size_t vertices{0u};
+    };
+
+    static inline constexpr const std::size_t vertices_per_sprite = 4u;
+    static inline constexpr const std::size_t indices_per_sprite = 6u;
+
+    SpriteBatch() noexcept = default;
+    SpriteBatch(const SpriteBatch& other) = delete;
+    SpriteBatch(SpriteBatch&& other) = delete;
+    SpriteBatch& operator=(const SpriteBatch& other) = delete;
+    SpriteBatch& operator=(SpriteBatch&& other) = delete;
+    ~SpriteBatch() noexcept = default;
+
+    void SetStateMode(StateMode mode) noexcept;
+    [[nodiscard]] StateMode GetStateMode() const noexcept;
+
+    //Sprites whose material is packed into the atlas are redirected to it,
+    //so different entity types can share a draw.
+    void SetAtlas(const SpriteAtlas* atlas) noexcept;
+
+    void Begin(const MaterialRegistry& registry) noexcept;
+    //hasState marks sprites whose shader reads SpriteInstance::state.
+    void Add(MaterialHandle material, SpriteInstance instance, bool hasState = false) noexcept;
+    //Groups the instances and bakes each group's vertices.
+    //Only touches the batch itself, so it may run on another thread.
+    void End() noexcept;
+    void Render(IRenderBackend& backend) const noexcept;
+    //Tallies what Render would submit without touching the device.
+    [[nodiscard]] Submission Record() const noexcept;
+
+    //Valid after End, ordered by draw.
+    [[nodiscard]] const std::vector<SpriteInstance>& GetInstances() const noexcept;
+    [[nodiscard]] const std::vector<Draw>& GetDraws() const noexcept;
+    [[nodiscard]] std::size_t GetDrawCallCount() const noexcept;
+    [[nodiscard]] std::size_t GetInstanceCount() const noexcept;
+
+    //Order-independent hashes of the added and the grouped sprites; equal when
+    //nothing changed a sprite between Add and End.
+    [[nodiscard]] uint64_t CalcAddedChecksum() const noexcept;
+    [[nodiscard]] uint64_t CalcGroupedChecksum() const noexcept;
+
+protected:
+private:
+    struct Entry {
+        std::size_t draw{0u};
+        SpriteInstance instance{};
+    };
+
+    [[nodiscard]] std::size_t FindOrAddDraw(MaterialHandle material, bool hasState, const Vector4& state) noexcept;
+    void BuildMesh(const Draw& draw, Mesh::Builder& builder) const noexcept;
+    [[nodiscard]] static uint64_t HashInstance(const SpriteInstance& instance) noexcept;
+
+    const MaterialRegistry* m_registry{nullptr};
+    const SpriteAtlas* m_atlas{nullptr};
+    StateMode m_state_mode{default_state_mode};
+    std::vector<Entry> m_entries{};
+    std::vector<SpriteInstance> m_instances{};
+    std::vector<Draw> m_draws{};
+    std::vector<Mesh::Builder> m_builders{};
+};
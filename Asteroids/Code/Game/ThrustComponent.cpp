@@ -10,7 +10,9 @@
 #include "Engine/Services/ServiceLocator.hpp"
 #include "Engine/Services/IRendererService.hpp"
 
+#include "Game/Game.hpp"
 #include "Game/GameCommon.hpp"
+#include "Game/RenderSnapshot.hpp"
 
 ThrustComponent::ThrustComponent(std::weak_ptr<Scene> scene, GameEntity* parent, float maxThrust /*= 100.0f*/)
 : GameEntity(scene.lock()->CreateEntity(), scene, parent)
@@ -23,16 +25,18 @@ ThrustComponent::ThrustComponent(std::weak_ptr<Scene> scene, GameEntity* parent,
     } else {
         UpdateComponent<TransformComponent>(Matrix4::I);
     }
+    kind = GameEntity::Kind::Thrust;
+    m_material = GetGameAs<Game>()->materials.thrust;
     SetCosmeticRadius(7.0f);
 }
 
 void ThrustComponent::BeginFrame() noexcept {
     m_thrustPS.BeginFrame();
-    m_mesh_builder.Clear();
 }
 
 void ThrustComponent::Update([[maybe_unused]] TimeUtils::FPSeconds deltaSeconds) noexcept {
-    if(MathUtils::IsEquivalentToZero(m_thrust)) {
+    m_visible = !MathUtils::IsEquivalentToZero(m_thrust);
+    if(!m_visible) {
         return;
     }
     auto* rs = ServiceLocator::get<IRendererService>();
@@ -45,35 +49,21 @@ void ThrustComponent::Update([[maybe_unused]] TimeUtils::FPSeconds deltaSeconds)
     const auto R = Matrix4::Create2DRotationDegreesMatrix(m_thrustDirectionAngleOffset);
     const auto T = Matrix4::CreateTranslationMatrix(m_positionOffset);
 
-    UpdateComponent<TransformComponent>(Matrix4::MakeRT(transform, Matrix4::MakeSRT(S, R, T)));
-
-    const auto uvs = AABB2::Zero_to_One;
-    auto& builder = m_mesh_builder;
-    builder.Begin(PrimitiveType::Triangles);
-    builder.SetColor(Rgba::White);
-
-    builder.SetUV(Vector2{ uvs.maxs.x, uvs.maxs.y });
-    builder.AddVertex(Vector2{ +0.5f, +0.5f });
-
-    builder.SetUV(Vector2{ uvs.mins.x, uvs.maxs.y });
-    builder.AddVertex(Vector2{ -0.5f, +0.5f });
-
-    builder.SetUV(Vector2{ uvs.mins.x, uvs.mins.y });
-    builder.AddVertex(Vector2{ -0.5f, -0.5f });
-
-    builder.SetUV(Vector2{ uvs.maxs.x, uvs.mins.y });
-    builder.AddVertex(Vector2{ +0.5f, -0.5f });
-
-    builder.AddIndicies(Mesh::Builder::Primitive::Quad);
-    builder.End(GetMaterial());
+    m_localTransform = Matrix4::MakeSRT(S, R, T);
+    UpdateComponent<TransformComponent>(Matrix4::MakeRT(transform, m_localTransform));
 }
 
 void ThrustComponent::Render() const noexcept {
     m_thrustPS.Render();
-    auto* rs = ServiceLocator::get<IRendererService>();
-    rs->SetModelMatrix(GetComponent<TransformComponent>());
-    Mesh::Render(m_mesh_builder);
+}
 
+void ThrustComponent::AppendToRenderSnapshot(RenderSnapshot& snapshot) const noexcept {
+    if(!m_visible) {
+        return;
+    }
+    //Follow the parent's interpolated pose so the flame does not lag the ship.
+    const auto transform = HasGameParent() ? Matrix4::MakeRT(GetGameParent()->CalcRenderTransform(), m_localTransform) : GetComponent<TransformComponent>().Transform;
+    snapshot.quads.push_back(RenderSnapshot::Quad{m_material, transform});
 }
 
 void ThrustComponent::EndFrame() noexcept {
@@ -116,7 +106,3 @@ float ThrustComponent::GetMaxThrust() const noexcept {
 void ThrustComponent::SetMaxThrust(float newMaxThrust) noexcept {
     m_maxThrust = newMaxThrust;
 }
-
-Material* ThrustComponent::GetMaterial() const noexcept {
-    return g_theRenderer->GetMaterial("thrust");
-}
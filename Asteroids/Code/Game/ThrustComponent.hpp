@@ -22,6 +22,7 @@ public:
     void BeginFrame() noexcept override;
     void Update([[maybe_unused]] TimeUtils::FPSeconds deltaSeconds) noexcept override;
     void Render() const noexcept override;
+    void AppendToRenderSnapshot(RenderSnapshot& snapshot) const noexcept override;
     void EndFrame() noexcept override;
 
     void OnCreate() noexcept override;
@@ -34,12 +35,13 @@ public:
     float GetMaxThrust() const noexcept;
     void SetMaxThrust(float newMaxThrust) noexcept;
 
-    Material* GetMaterial() const noexcept override;
 protected:
 private:
     ParticleEffect m_thrustPS{"flame_emission"};
+    Matrix4 m_localTransform{};
     Vector2 m_positionOffset{};
     float m_thrustDirectionAngleOffset{0.0f};
     float m_thrust{0.0f};
     float m_maxThrust{100.0f};
+    bool m_visible{false};
 };
@@ -68,7 +68,8 @@ void TitleState::Render() const noexcept {
     g_theRenderer->DrawTextLine(font, "ASTEROIDS");
 
     g_theRenderer->SetModelMatrix(Matrix4::CreateTranslationMatrix(Vector2{ui_view_half_extents.x, ui_view_half_extents.y + line_height * 2.0f}));
-    g_theRenderer->DrawTextLine(font, "START", m_selected_item == TitleMenu::Start ? Rgba::Yellow : Rgba::White);
+    const auto assets_ready = GetGameAs<Game>()->AreAssetsReady();
+    g_theRenderer->DrawTextLine(font, assets_ready ? "START" : "LOADING...", m_selected_item == TitleMenu::Start ? Rgba::Yellow : Rgba::White);
 
     g_theRenderer->SetModelMatrix(Matrix4::CreateTranslationMatrix(Vector2{ui_view_half_extents.x, ui_view_half_extents.y + line_height * 4.0f}));
     g_theRenderer->DrawTextLine(font, "OPTIONS", m_selected_item == TitleMenu::Options ? Rgba::Yellow : Rgba::White);
@@ -117,7 +118,7 @@ std::unique_ptr<GameState> TitleState::HandleKeyboardInput() noexcept {
     if(select) {
         switch(m_selected_item) {
         case TitleMenu::Start:
-            return std::make_unique<MainState>();
+            return GetGameAs<Game>()->AreAssetsReady() ? std::make_unique<MainState>() : nullptr;
         case TitleMenu::Options:
             return std::make_unique<OptionsState>();
         case TitleMenu::Exit:
@@ -151,7 +152,7 @@ std::unique_ptr<GameState> TitleState::HandleControllerInput() noexcept {
             if(select) {
                 switch(m_selected_item) {
                 case TitleMenu::Start:
-                    return std::make_unique<MainState>();
+                    return game->AreAssetsReady() ? std::make_unique<MainState>() : nullptr;
                 case TitleMenu::Options:
                     return std::make_unique<OptionsState>();
                 case TitleMenu::Exit:
@@ -6,7 +6,6 @@
 
 #include "Engine/Renderer/AnimatedSprite.hpp"
 #include "Engine/Renderer/SpriteSheet.hpp"
-#include "Engine/Renderer/ConstantBuffer.hpp"
 #include "Engine/Renderer/Material.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/Shader.hpp"
@@ -15,6 +14,7 @@
 
 #include "Engine/Scene/Components.hpp"
 #include "Engine/Services/ServiceLocator.hpp"
+#include "Engine/Services/IAudioService.hpp"
 #include "Engine/Services/IRendererService.hpp"
 
 #include "Game/Bullet.hpp"
@@ -22,6 +22,7 @@
 #include "Game/Game.hpp"
 #include "Game/Ship.hpp"
 
+#include "Game/CollisionResponse.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/GameConfig.hpp"
 #include "Game/MainState.hpp"
@@ -38,24 +39,23 @@ Ufo::Ufo(std::weak_ptr<Scene> scene, Type type, Vector2 position)
     SetVelocity(Vector2::X_Axis * 100.0f);
     SetHealth(GetHealthFromType(_type));
     faction = GameEntity::Faction::Enemy;
+    kind = GameEntity::Kind::Ufo;
+    m_material = GetGameAs<Game>()->materials.ufo;
     _bulletSpeed = GetBulletSpeedFromTypeAndDifficulty(_type);
     _fireRate.SetFrequency(GetFireRateFromTypeAndDifficulty(_type));
-    _style = GetStyleFromType(_type);
+    _style = GetStyleFromType(_type, GetRandom());
     scoreValue = GetValueFromType(_type);
 
+    auto* rs = ServiceLocator::get<IRendererService>();
     AnimatedSpriteDesc desc{};
-    desc.material = g_theRenderer->GetMaterial("ufo");
+    desc.material = GetMaterial();
     desc.spriteSheet = GetSpriteSheet();
     desc.durationSeconds = TimeUtils::FPSeconds{0.3f};
     desc.playbackMode = AnimatedSprite::SpriteAnimMode::Looping;
     desc.frameLength = GetFrameLengthFromTypeAndStyle(_type, _style);
     desc.startSpriteIndex = GetStartIndexFromTypeAndStyle(_type, _style);
 
-    if(auto cbs = GetMaterial()->GetShader()->GetConstantBuffers(); !cbs.empty()) {
-        ufo_state_cb = &cbs[0].get();
-    }
-
-    _sprite = g_theRenderer->CreateAnimatedSprite(desc);
+    _sprite = rs->CreateAnimatedSprite(desc);
 
 }
 
@@ -70,50 +70,31 @@ void Ufo::BeginFrame() noexcept {
 void Ufo::Update(TimeUtils::FPSeconds deltaSeconds) noexcept {
     GameEntity::Update(deltaSeconds);
     _timeSinceLastHit += deltaSeconds;
-    _sprite->Update(deltaSeconds);
 
     if(_canFire) {
         OnFire();
     }
 
-    const auto uvs = _sprite->GetCurrentTexCoords();
+    //Headless runs have no sprite; everything below only feeds rendering.
+    if(!_sprite) {
+        return;
+    }
+    RefreshSpriteMaterial(*_sprite);
+    _sprite->Update(deltaSeconds);
+
     const auto frameWidth = static_cast<float>(_sprite->GetFrameDimensions().x);
     const auto frameHeight = static_cast<float>(_sprite->GetFrameDimensions().y);
     const auto half_extents = Vector2{frameWidth, frameHeight};
     const auto scale = GetScaleFromType(_type);
-    {
-        const auto S = Matrix4::CreateScaleMatrix(scale * half_extents);
-        const auto R = Matrix4::Create2DRotationDegreesMatrix(GetOrientationDegrees());
-        const auto T = Matrix4::CreateTranslationMatrix(GetPosition());
-        UpdateComponent<TransformComponent>(Matrix4::MakeSRT(S, R, T));
-    }
-
-    auto& builder = m_mesh_builder;
-    builder.Begin(PrimitiveType::Triangles);
-    builder.SetColor(Rgba::White);
-
-    builder.SetUV(Vector2{uvs.maxs.x, uvs.maxs.y});
-    builder.AddVertex(Vector2{+0.5f, +0.5f});
-
-    builder.SetUV(Vector2{uvs.mins.x, uvs.maxs.y});
-    builder.AddVertex(Vector2{-0.5f, +0.5f});
-
-    builder.SetUV(Vector2{uvs.mins.x, uvs.mins.y});
-    builder.AddVertex(Vector2{-0.5f, -0.5f});
-
-    builder.SetUV(Vector2{uvs.maxs.x, uvs.mins.y});
-    builder.AddVertex(Vector2{+0.5f, -0.5f});
-
-    builder.AddIndicies(Mesh::Builder::Primitive::Quad);
-    builder.End(GetMaterial());
-
+    UpdateTransform(scale * half_extents);
 }
 
-void Ufo::Render() const noexcept {
-    ufo_state.wasHitUfoIndex.x = WasHit();
-    ufo_state.wasHitUfoIndex.y = GetUfoIndexFromStyle(_style);
-    ufo_state_cb->Update(*ServiceLocator::get<IRendererService>()->GetDeviceContext(), &ufo_state);
-    GameEntity::Render();
+bool Ufo::AppendToSpriteBatch(SpriteBatch& batch) const noexcept {
+    //x is the hit flag, y the style index.
+    const auto state = Vector4{WasHit(), GetUfoIndexFromStyle(_style), 0.0f, 0.0f};
+    const auto uvs = _sprite ? _sprite->GetCurrentTexCoords() : AABB2::Zero_to_One;
+    batch.Add(m_material, MakeSpriteInstance(uvs, state), true);
+    return true;
 }
 
 void Ufo::EndFrame() noexcept {
@@ -121,34 +102,22 @@ void Ufo::EndFrame() noexcept {
 }
 
 void Ufo::OnCreate() noexcept {
-    AudioSystem::SoundDesc desc{};
-    desc.volume = 1.0f;
-    desc.frequency = 1.0f;
-    desc.loopCount = -1;
-    desc.groupName = g_audiogroup_sound;
-    _warble_sound = g_theAudioSystem->CreateSound(g_sound_warblepath);
-    g_theAudioSystem->Play(*_warble_sound, desc);
+    if(auto* game = GetGameAs<Game>(); game != nullptr) {
+        game->GetAudio().Play(game->sounds.warble);
+    }
 }
 
 void Ufo::OnCollision(GameEntity* a, GameEntity* b) noexcept {
-    if(a->faction == b->faction) {
-        return;
-    }
-    switch(b->faction) {
-    case GameEntity::Faction::Player:
-    {
-        if(const auto* asBullet = dynamic_cast<Bullet*>(b); asBullet != nullptr) {
-            a->DecrementHealth();
-            OnHit();
-        }
-        if(const auto* asMine = dynamic_cast<Mine*>(b); asMine != nullptr) {
-            a->Kill();
-        }
-        break;
-    }
-    default:
-        break;
-    }
+    CollisionResponse::Dispatch(*a, *b);
+}
+
+void Ufo::OnHitBy([[maybe_unused]] Bullet& bullet) noexcept {
+    DecrementHealth();
+    OnHit();
+}
+
+void Ufo::OnHitBy([[maybe_unused]] Mine& mine) noexcept {
+    Kill();
 }
 
 void Ufo::OnFire() noexcept {
@@ -162,21 +131,17 @@ void Ufo::OnHit() noexcept {
     if(TimeUtils::FPFrames{1.0f} < _timeSinceLastHit) {
         _timeSinceLastHit = _timeSinceLastHit.zero();
     }
-    AudioSystem::SoundDesc desc{};
-    desc.groupName = g_audiogroup_sound;
-    g_theAudioSystem->Play(g_sound_hitpath, desc);
-    ufo_state.wasHitUfoIndex.x = WasHit();
+    if(auto* game = GetGameAs<Game>(); game != nullptr) {
+        game->GetAudio().Play(game->sounds.hit);
+    }
 }
 
 void Ufo::OnDestroy() noexcept {
-    for(auto* channel : _warble_sound->GetChannels()) {
-        channel->Stop();
-    }
     GameEntity::OnDestroy();
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        if (auto* const mainState = dynamic_cast<MainState* const>(game->GetCurrentState()); mainState != nullptr) {
-            mainState->MakeExplosion(GetPosition());
-        }
+        //Every ufo shares the one looping warble, so this silences all of them as before.
+        game->GetAudio().Stop(game->sounds.warble);
+        game->GetSpawnQueue().Push(SpawnRequest::ForExplosion(GetPosition()));
     }
 }
 
@@ -188,9 +153,7 @@ void Ufo::MakeBullet() const noexcept {
     const auto source = GetPosition();
     const auto angle = (_fireTarget - source).CalcHeadingDegrees();
     if(auto* game = GetGameAs<Game>(); game != nullptr) {
-        if (auto* const mainState = dynamic_cast<MainState* const>(game->GetCurrentState()); mainState != nullptr) {
-            mainState->MakeBullet(this, source, Vector2::CreateFromPolarCoordinatesDegrees(_bulletSpeed, angle));
-        }
+        game->GetSpawnQueue().Push(SpawnRequest::ForBullet(this, source, Vector2::CreateFromPolarCoordinatesDegrees(_bulletSpeed, angle)));
     }
 }
 
@@ -262,7 +225,7 @@ float Ufo::GetBulletSpeedFromTypeAndDifficulty(Type type) const noexcept {
 }
 
 Vector2 Ufo::CalculateFireTarget() const noexcept {
-    const auto defaultTarget = GetPosition() + Vector2::CreateFromPolarCoordinatesDegrees(1.0f, MathUtils::GetRandomInRange<float>(0.0f, 359.0f));
+    const auto defaultTarget = GetPosition() + Vector2::CreateFromPolarCoordinatesDegrees(1.0f, GetRandom().GetInRange<float>(0.0f, 359.0f));
     switch(_type) {
     case Type::Small: {
         const auto loc = [this, &defaultTarget]() {
@@ -292,7 +255,7 @@ Vector2 Ufo::CalculateFireTarget() const noexcept {
                         const auto source = GetPosition();
                         const auto angle = (target - source).CalcHeadingDegrees();
                         const auto offset_range = 90.0f;
-                        const auto offset = MathUtils::GetRandomNegOneToOne<float>() * offset_range;
+                        const auto offset = GetRandom().GetNegOneToOne<float>() * offset_range;
                         return GetPosition() + Vector2::CreateFromPolarCoordinatesDegrees(1.0f, angle + offset);
                     }
                 }
@@ -335,10 +298,6 @@ int Ufo::GetHealthFromType(Type type) noexcept {
     }
 }
 
-Material* Ufo::GetMaterial() const noexcept {
-    return g_theRenderer->GetMaterial("ufo");
-}
-
 int Ufo::GetStartIndexFromTypeAndStyle(Type type, Style style) noexcept {
     switch(type) {
     case Type::Small:
@@ -407,21 +366,21 @@ long long Ufo::GetValueFromType(Type type) noexcept {
     }
 }
 
-Ufo::Style Ufo::GetStyleFromType(Type type) noexcept {
+Ufo::Style Ufo::GetStyleFromType(Type type, RandomStream& rng) noexcept {
     switch(type) {
     case Type::Small:
     {
-        const auto i = MathUtils::GetRandomInRange<int>(static_cast<int>(Style::First_Small), static_cast<int>(Style::Last_Small));
+        const auto i = rng.GetInRange<int>(static_cast<int>(Style::First_Small), static_cast<int>(Style::Last_Small));
         return static_cast<Style>(i);
     }
     case Type::Big:
     {
-        const auto i = MathUtils::GetRandomInRange<int>(static_cast<int>(Style::First_Big), static_cast<int>(Style::Last_Big));
+        const auto i = rng.GetInRange<int>(static_cast<int>(Style::First_Big), static_cast<int>(Style::Last_Big));
         return static_cast<Style>(i);
     }
     case Type::Boss:
     {
-        const auto i = MathUtils::GetRandomInRange<int>(static_cast<int>(Style::First_Boss), static_cast<int>(Style::Last_Boss));
+        const auto i = rng.GetInRange<int>(static_cast<int>(Style::First_Boss), static_cast<int>(Style::Last_Boss));
         return static_cast<Style>(i);
     }
     default:
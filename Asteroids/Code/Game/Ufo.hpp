@@ -1,15 +1,16 @@
 #pragma once
 
 #include "Engine/Audio/AudioSystem.hpp"
-#include "Engine/Core/Stopwatch.hpp"
 
 #include "Engine/Scene/Scene.hpp"
 
 #include "Game/GameEntity.hpp"
+#include "Game/SimStopwatch.hpp"
 
 #include <memory>
 
-class ConstantBuffer;
+class Bullet;
+class Mine;
 
 class Ufo : public GameEntity {
 public:
@@ -41,11 +42,13 @@ public:
 
     void BeginFrame() noexcept override;
     void Update(TimeUtils::FPSeconds deltaSeconds) noexcept override;
-    void Render() const noexcept override;
+    bool AppendToSpriteBatch(SpriteBatch& batch) const noexcept override;
     void EndFrame() noexcept override;
 
     void OnCreate() noexcept override;
     void OnCollision(GameEntity* a, GameEntity* b) noexcept override;
+    void OnHitBy(Bullet& bullet) noexcept;
+    void OnHitBy(Mine& mine) noexcept;
     void OnHit() noexcept;
     void OnFire() noexcept override;
     void OnDestroy() noexcept override;
@@ -53,14 +56,13 @@ public:
     static float GetCosmeticRadiusFromType(Type type) noexcept;
     static float GetPhysicalRadiusFromType(Type type) noexcept;
     static float GetScaleFromType(Type type) noexcept;
-    static Style GetStyleFromType(Type type) noexcept;
+    static Style GetStyleFromType(Type type, RandomStream& rng) noexcept;
     static int GetStartIndexFromTypeAndStyle(Type type, Style style) noexcept;
     static int GetFrameLengthFromTypeAndStyle(Type type, Style style) noexcept;
     static long long GetValueFromType(Type type) noexcept;
     static unsigned int GetFireRateFromTypeAndDifficulty(Type type) noexcept;
     static float GetUfoIndexFromStyle(Style style) noexcept;
     static int GetHealthFromType(Type type) noexcept;
-    Material* GetMaterial() const noexcept override;
 protected:
 
     float GetBulletSpeedFromTypeAndDifficulty(Type type) const noexcept;
@@ -72,18 +74,11 @@ protected:
 
     void MakeBullet() const noexcept;
 
-    struct ufo_state_t {
-        Vector4 wasHitUfoIndex = Vector4::Y_Axis;
-    };
-
-    ConstantBuffer* ufo_state_cb{nullptr};
-    mutable ufo_state_t ufo_state{};
     Type _type{Type::Small};
     Style _style{Style::Blue};
     std::unique_ptr<class AnimatedSprite> _sprite{};
     TimeUtils::FPSeconds _timeSinceLastHit{0.0f};
-    Stopwatch _fireRate{};
-    AudioSystem::Sound* _warble_sound{};
+    SimStopwatch _fireRate{};
     Vector2 _fireTarget{};
     float _bulletSpeed{800.0f};
     bool _canFire{false};
@@ -0,0 +1,77 @@
+#include "Game/UnitQuad.hpp"
+
+#include "Engine/Core/Rgba.hpp"
+
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include "Game/GameEntity.hpp"
+#include "Game/IRenderBackend.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace UnitQuad {
+
+namespace {
+
+using Key = std::pair<const Material*, uint8_t>;
+
+[[nodiscard]] std::map<Key, Mesh::Builder>& GetCache() noexcept {
+    static std::map<Key, Mesh::Builder> cache{};
+    return cache;
+}
+
+void Build(Mesh::Builder& builder, Material* material, float alpha) noexcept {
+    const auto uvs = AABB2::Zero_to_One;
+    builder.Begin(PrimitiveType::Triangles);
+    builder.SetColor(Rgba::White);
+    builder.SetAlpha(alpha);
+
+    builder.SetUV(Vector2{uvs.maxs.x, uvs.maxs.y});
+    builder.AddVertex(Vector2{+0.5f, +0.5f});
+
+    builder.SetUV(Vector2{uvs.mins.x, uvs.maxs.y});
+    builder.AddVertex(Vector2{-0.5f, +0.5f});
+
+    builder.SetUV(Vector2{uvs.mins.x, uvs.mins.y});
+    builder.AddVertex(Vector2{-0.5f, -0.5f});
+
+    builder.SetUV(Vector2{uvs.maxs.x, uvs.mins.y});
+    builder.AddVertex(Vector2{+0.5f, -0.5f});
+
+    builder.AddIndicies(Mesh::Builder::Primitive::Quad);
+    builder.End(material);
+}
+
+} // namespace
+
+const Mesh::Builder& Get(Material* material, float alpha /*= 1.0f*/) noexcept {
+    //Vertex colors are 8 bits per channel, so there are at most 256 distinct alphas per material.
+    const auto alpha_byte = static_cast<uint8_t>(std::lround(std::clamp(alpha, 0.0f, 1.0f) * 255.0f));
+    auto& cache = GetCache();
+    const auto [iter, inserted] = cache.try_emplace(Key{material, alpha_byte});
+    if(inserted) {
+        Build(iter->second, material, static_cast<float>(alpha_byte) / 255.0f);
+    }
+    return iter->second;
+}
+
+void Render(IRenderBackend& backend, MaterialHandle material, const Matrix4& transform, float alpha /*= 1.0f*/) noexcept {
+    //An unresolved handle would otherwise build and cache a quad under a null key.
+    auto* resolved = GameEntity::GetMaterialRegistry().GetMaterial(material);
+    if(resolved == nullptr) {
+        return;
+    }
+    backend.SetModelMatrix(transform);
+    backend.DrawMesh(material, Get(resolved, alpha), vertex_count, index_count);
+}
+
+void Clear() noexcept {
+    GetCache().clear();
+}
+
+} // namespace UnitQuad
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Engine/Math/Matrix4.hpp"
+
+#include "Engine/Renderer/Mesh.hpp"
+
+#include "Game/MaterialRegistry.hpp"
+
+#include <cstddef>
+
+class IRenderBackend;
+class Material;
+
+//Immutable +/-0.5 quads with full-texture UVs. Each one is built the first time
+//a material and alpha pair is asked for and then shared by every entity that
+//draws it, so entities only supply a model matrix per frame.
+//Only entities outside the SpriteBatch use these, i.e. the ship and its thrust.
+namespace UnitQuad {
+
+inline constexpr const std::size_t vertex_count = 4u;
+inline constexpr const std::size_t index_count = 6u;
+
+[[nodiscard]] const Mesh::Builder& Get(Material* material, float alpha = 1.0f) noexcept;
+void Render(IRenderBackend& backend, MaterialHandle material, const Matrix4& transform, float alpha = 1.0f) noexcept;
+//Drops every cached quad, e.g. after materials are reloaded.
+void Clear() noexcept;
+
+} // namespace UnitQuad
@@ -16,16 +16,19 @@ cbuffer asteroid_state_cb : register(b3) {
     float4 wasHit;
 }
 
+//SpriteBatch writes the per-sprite state into the normal: x is the hit flag.
 struct vs_in_t {
     float3 position : POSITION;
     float4 color : COLOR;
     float2 uv : UV;
+    float3 state : NORMAL;
 };
 
 struct ps_in_t {
     float4 position : SV_POSITION;
     float4 color : COLOR;
     float2 uv : UV;
+    nointerpolation float3 state : NORMAL;
 };
 
 SamplerState sSampler : register(s0);
@@ -49,6 +52,7 @@ ps_in_t VertexFunction(vs_in_t input_vertex) {
     output.position = clip;
     output.color = input_vertex.color;
     output.uv = input_vertex.uv;
+    output.state = input_vertex.state;
 
     return output;
 }
@@ -56,8 +60,9 @@ ps_in_t VertexFunction(vs_in_t input_vertex) {
 float4 PixelFunction(ps_in_t input_pixel) : SV_Target0 {
     float4 albedo = tDiffuse.Sample(sSampler, input_pixel.uv);
     float4 tinted_color = albedo * input_pixel.color;
-    float4 white = float4(1.0f, 1.0f, 1.0f, tinted_color.a);
-    if(wasHit.x > 0.0f) {
+    //The cbuffer is only written in SpriteBatch's ConstantBuffer mode.
+    float was_hit = max(wasHit.x, input_pixel.state.x);
+    if(was_hit > 0.0f) {
         return float4(1.0f, 1.0f, 1.0f, tinted_color.a);
     }
     return tinted_color;
@@ -0,0 +1,84 @@
+cbuffer matrix_cb : register(b0) {
+    float4x4 g_MODEL;
+    float4x4 g_VIEW;
+    float4x4 g_PROJECTION;
+};
+
+cbuffer time_cb : register(b1) {
+    float g_GAME_TIME;
+    float g_SYSTEM_TIME;
+    float g_GAME_FRAME_TIME;
+    float g_SYSTEM_FRAME_TIME;
+}
+
+cbuffer ufo_state_cb : register(b3) {
+    float4 wasHitUfoIndex;
+    float4 color;
+}
+
+//SpriteBatch writes the per-sprite state into the normal: x is the hit flag, y the style index.
+struct vs_in_t {
+    float3 position : POSITION;
+    float4 color : COLOR;
+    float2 uv : UV;
+    float3 state : NORMAL;
+};
+
+struct ps_in_t {
+    float4 position : SV_POSITION;
+    float4 color : COLOR;
+    float2 uv : UV;
+    nointerpolation float3 state : NORMAL;
+};
+
+SamplerState sSampler : register(s0);
+
+Texture2D<float4> tDiffuse    : register(t0);
+Texture2D<float4> tNormal   : register(t1);
+Texture2D<float4> tDisplacement : register(t2);
+Texture2D<float4> tSpecular : register(t3);
+Texture2D<float4> tOcclusion : register(t4);
+Texture2D<float4> tEmissive : register(t5);
+
+
+ps_in_t VertexFunction(vs_in_t input_vertex) {
+    ps_in_t output;
+
+    float4 local = float4(input_vertex.position, 1.0f);
+    float4 world = mul(local, g_MODEL);
+    float4 view = mul(world, g_VIEW);
+    float4 clip = mul(view, g_PROJECTION);
+
+    output.position = clip;
+    output.color = input_vertex.color;
+    output.uv = input_vertex.uv;
+    output.state = input_vertex.state;
+
+    return output;
+}
+
+//Ufo::GetUfoIndexFromStyle
+float3 GetStyleColor(int ufo_index) {
+    switch(ufo_index) {
+    case 0: return float3(0.0f, 0.0f, 1.0f);
+    case 1: return float3(0.0f, 1.0f, 0.0f);
+    case 2: return float3(1.0f, 1.0f, 0.0f);
+    default: return float3(1.0f, 0.0f, 1.0f);
+    }
+}
+
+float4 PixelFunction(ps_in_t input_pixel) : SV_Target0 {
+    float4 albedo = tDiffuse.Sample(sSampler, input_pixel.uv);
+    //The sheet marks the recolorable parts in magenta.
+    bool is_key = albedo.r > 0.5f && albedo.g < 0.5f && albedo.b > 0.5f && albedo.a > 0.5f;
+    if(is_key) {
+        albedo = float4(GetStyleColor((int)input_pixel.state.y), 1.0f);
+    }
+    float4 tinted_color = albedo * input_pixel.color;
+    //The cbuffer is only written in SpriteBatch's ConstantBuffer mode.
+    float was_hit = max(wasHitUfoIndex.x, input_pixel.state.x);
+    if(was_hit > 0.0f) {
+        return float4(1.0f, 1.0f, 1.0f, tinted_color.a);
+    }
+    return tinted_color;
+}